@@ -53,7 +53,7 @@ void TestLinkedList() {
 
 void TestArraySequence() {
     int items[] = {5, 10, 15};
-    ArraySequence<int> seq(items, 3);
+    ImmutableArraySequence<int> seq(items, 3);
 
     assert(seq.GetLength() == 3);
     assert(seq.Get(0) == 5);
@@ -82,7 +82,7 @@ void TestArraySequence() {
     delete sub;
 
     int other[] = {100, 200};
-    ArraySequence<int> otherSeq(other, 2);
+    ImmutableArraySequence<int> otherSeq(other, 2);
     Sequence<int>* concat = seq.Concat(otherSeq);
     assert(concat->GetLength() == 5);
     assert(concat->Get(3) == 100);
@@ -92,7 +92,7 @@ void TestArraySequence() {
 
 void TestListSequence() {
     int items[] = {1, 2, 3};
-    ListSequence<int> seq(items, 3);
+    ImmutableListSequence<int> seq(items, 3);
 
     assert(seq.GetLength() == 3);
     assert(seq.Get(1) == 2);
@@ -120,7 +120,7 @@ void TestListSequence() {
     delete sub;
 
     int other[] = {10, 11};
-    ListSequence<int> otherSeq(other, 2);
+    ImmutableListSequence<int> otherSeq(other, 2);
     Sequence<int>* concat = seq.Concat(otherSeq);
     assert(concat->GetLength() == 5);
     assert(concat->Get(3) == 10);
@@ -1,5 +1,5 @@
 #include <iostream>
-#include "TESTS.h"
+#include "Tests.h"
 
 int main() {
     try {
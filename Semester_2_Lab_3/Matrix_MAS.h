@@ -6,6 +6,8 @@
 #include <stdexcept>
 #include <cmath>
 #include <vector>
+#include <span>
+#include <algorithm>
 
 template<typename T>
 class Matrix {
@@ -38,8 +40,22 @@ public:
 private:
     int n, m;
     MutableArraySequence<MutableArraySequence<T>> data;
+
+    // Копирует строки в непрерывный буфер rows*cols (без промежуточных копий строк)
+    // и раскладывает указатели на начала строк в rowPtr.
+    void copyRowsTo(std::vector<T>& buf, int cols, int offset, std::vector<T*>& rowPtr) const;
 };
 
+template<typename T>
+void Matrix<T>::copyRowsTo(std::vector<T>& buf, int cols, int offset, std::vector<T*>& rowPtr) const {
+    std::span<const MutableArraySequence<T>> rows = data.AsSpan();
+    for (int i = 0; i < n; ++i) {
+        std::span<const T> row = rows[i].AsSpan();
+        rowPtr[i] = buf.data() + static_cast<std::size_t>(i) * cols;
+        std::copy(row.begin(), row.end(), rowPtr[i] + offset);
+    }
+}
+
 template<typename T>
 Matrix<T>::Matrix(int n_, int m_)
     : n(n_), m(m_) {
@@ -83,16 +99,20 @@ Matrix<T>& Matrix<T>::operator=(const Matrix<T>& other) {
     return *this;
 }
 
+// Размеры строк известны (n x m), поэтому внутренние циклы работают
+// со ссылками data[i][j] без копирования строк и проверок на каждом элементе.
+// Индексы, пришедшие снаружи, проверяются один раз на входе.
+
 template<typename T>
 Matrix<T> Matrix<T>::operator+(const Matrix<T>& o) const {
     if (n != o.n || m != o.m) throw std::invalid_argument("Matrix dimensions must match");
     Matrix<T> r(n, m);
     for (int i = 0; i < n; ++i) {
-        T* buf = new T[m];
+        const MutableArraySequence<T>& a = data[i];
+        const MutableArraySequence<T>& b = o.data[i];
+        MutableArraySequence<T>& dst = r.data[i];
         for (int j = 0; j < m; ++j)
-            buf[j] = data.Get(i).Get(j) + o.data.Get(i).Get(j);
-        r.data.Set(i, MutableArraySequence<T>(buf, m));
-        delete[] buf;
+            dst[j] = a[j] + b[j];
     }
     return r;
 }
@@ -102,15 +122,15 @@ Matrix<T> Matrix<T>::operator*(const Matrix<T>& o) const {
     if (m != o.n) throw std::invalid_argument("Inner dimensions must match");
     Matrix<T> r(n, o.m);
     for (int i = 0; i < n; ++i) {
-        T* buf = new T[o.m];
-        for (int j = 0; j < o.m; ++j) {
-            T sum = T(0);
-            for (int k = 0; k < m; ++k)
-                sum += data.Get(i).Get(k) * o.data.Get(k).Get(j);
-            buf[j] = sum;
+        const MutableArraySequence<T>& a = data[i];
+        MutableArraySequence<T>& dst = r.data[i];
+        // порядок i-k-j: строка o.data[k] читается подряд
+        for (int k = 0; k < m; ++k) {
+            T aik = a[k];
+            const MutableArraySequence<T>& b = o.data[k];
+            for (int j = 0; j < o.m; ++j)
+                dst[j] += aik * b[j];
         }
-        r.data.Set(i, MutableArraySequence<T>(buf, o.m));
-        delete[] buf;
     }
     return r;
 }
@@ -119,11 +139,10 @@ template<typename T>
 Matrix<T> Matrix<T>::operator*(T k) const {
     Matrix<T> r(n, m);
     for (int i = 0; i < n; ++i) {
-        T* buf = new T[m];
+        const MutableArraySequence<T>& a = data[i];
+        MutableArraySequence<T>& dst = r.data[i];
         for (int j = 0; j < m; ++j)
-            buf[j] = data.Get(i).Get(j) * k;
-        r.data.Set(i, MutableArraySequence<T>(buf, m));
-        delete[] buf;
+            dst[j] = a[j] * k;
     }
     return r;
 }
@@ -131,50 +150,46 @@ Matrix<T> Matrix<T>::operator*(T k) const {
 template<typename T>
 Matrix<T> Matrix<T>::Transpose() const {
     Matrix<T> r(m, n);
-    for (int i = 0; i < m; ++i) {
-        T* buf = new T[n];
-        for (int j = 0; j < n; ++j)
-            buf[j] = data.Get(j).Get(i);
-        r.data.Set(i, MutableArraySequence<T>(buf, n));
-        delete[] buf;
+    for (int j = 0; j < n; ++j) {
+        const MutableArraySequence<T>& a = data[j];
+        for (int i = 0; i < m; ++i)
+            r.data[i][j] = a[i];
     }
     return r;
 }
 
 template<typename T>
 void Matrix<T>::SwapRows(int a, int b) {
-    auto ra = data.Get(a);
-    auto rb = data.Get(b);
-    data.Set(a, rb);
-    data.Set(b, ra);
+    if (a < 0 || a >= n || b < 0 || b >= n)
+        throw std::out_of_range("Row index out of range");
+    std::swap(data[a], data[b]);
 }
 
 template<typename T>
 void Matrix<T>::SwapColumns(int a, int b) {
+    if (a < 0 || a >= m || b < 0 || b >= m)
+        throw std::out_of_range("Column index out of range");
     for (int i = 0; i < n; ++i) {
-        auto row = data.Get(i);
-        T t = row.Get(a);
-        row.Set(a, row.Get(b));
-        row.Set(b, t);
-        data.Set(i, row);
+        MutableArraySequence<T>& row = data[i];
+        std::swap(row[a], row[b]);
     }
 }
 
 template<typename T>
 void Matrix<T>::ScaleRow(int ind, T k) {
-    auto row = data.Get(ind);
+    if (ind < 0 || ind >= n)
+        throw std::out_of_range("Row index out of range");
+    MutableArraySequence<T>& row = data[ind];
     for (int j = 0; j < m; ++j)
-        row.Set(j, row.Get(j) * k);
-    data.Set(ind, row);
+        row[j] *= k;
 }
 
 template<typename T>
 void Matrix<T>::ScaleColumn(int ind, T k) {
-    for (int i = 0; i < n; ++i) {
-        auto row = data.Get(i);
-        row.Set(ind, row.Get(ind) * k);
-        data.Set(i, row);
-    }
+    if (ind < 0 || ind >= m)
+        throw std::out_of_range("Column index out of range");
+    for (int i = 0; i < n; ++i)
+        data[i][ind] *= k;
 }
 
 template<typename T>
@@ -184,28 +199,31 @@ void Matrix<T>::multiplyRow(int row, T k) {
 
 template<typename T>
 void Matrix<T>::addLinearCombination(int s, int t, T k) {
-    auto rs = data.Get(s);
-    auto rt = data.Get(t);
+    if (s < 0 || s >= n || t < 0 || t >= n)
+        throw std::out_of_range("Row index out of range");
+    const MutableArraySequence<T>& rs = data[s];
+    MutableArraySequence<T>& rt = data[t];
     for (int j = 0; j < m; ++j)
-        rt.Set(j, rt.Get(j) + rs.Get(j) * k);
-    data.Set(t, rt);
+        rt[j] += rs[j] * k;
 }
 
 template<typename T>
 void Matrix<T>::print() const {
     for (int i = 0; i < n; ++i) {
         for (int j = 0; j < m; ++j)
-            std::cout << data.Get(i).Get(j) << " ";
+            std::cout << data[i][j] << " ";
         std::cout << "\n";
     }
 }
 
 template<typename T>
 int Matrix<T>::findBiggestInColumn(int col, int startRow) const {
+    if (startRow < 0 || startRow >= n || col < 0 || col >= m)
+        throw std::out_of_range("Index out of range");
     int idx = startRow;
-    T maxv = std::abs(data.Get(startRow).Get(col));
+    T maxv = std::abs(data[startRow][col]);
     for (int i = startRow + 1; i < n; ++i) {
-        T v = std::abs(data.Get(i).Get(col));
+        T v = std::abs(data[i][col]);
         if (v > maxv) { maxv = v; idx = i; }
     }
     return idx;
@@ -214,10 +232,9 @@ int Matrix<T>::findBiggestInColumn(int col, int startRow) const {
 template<typename T>
 T Matrix<T>::determinant() const {
     if (n != m) throw std::domain_error("Determinant defined only for square matrices");
-    std::vector<std::vector<T>> tmp(n, std::vector<T>(m));
-    for (int i = 0; i < n; ++i)
-        for (int j = 0; j < m; ++j)
-            tmp[i][j] = data.Get(i).Get(j);
+    std::vector<T> buf(static_cast<std::size_t>(n) * m);
+    std::vector<T*> tmp(n);
+    copyRowsTo(buf, m, 0, tmp);
     T det = T(1);
     for (int i = 0; i < n; ++i) {
         int p = i;
@@ -242,13 +259,11 @@ template<typename T>
 Matrix<T> Matrix<T>::solveSLAE(const Matrix<T>& b) const {
     if (n != m || b.n != n) throw std::invalid_argument("Invalid dimensions for SLAE");
     int cols = m + b.m;
-    std::vector<std::vector<T>> aug(n, std::vector<T>(cols));
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < m; ++j)
-            aug[i][j] = data.Get(i).Get(j);
-        for (int j = 0; j < b.m; ++j)
-            aug[i][m + j] = b.data.Get(i).Get(j);
-    }
+    std::vector<T> buf(static_cast<std::size_t>(n) * cols);
+    std::vector<T*> aug(n);
+    std::vector<T*> bRows(n);
+    copyRowsTo(buf, cols, 0, aug);
+    b.copyRowsTo(buf, cols, m, bRows);
     for (int i = 0; i < n; ++i) {
         int p = i;
         for (int r = i; r < n; ++r)
@@ -276,12 +291,8 @@ Matrix<T> Matrix<T>::solveSLAE(const Matrix<T>& b) const {
 template<typename T>
 Matrix<T> Matrix<T>::getInverse() const {
     Matrix<T> I(n, n);
-    for (int i = 0; i < n; ++i) {
-        auto r = I.data.Get(i);
-        for (int j = 0; j < n; ++j)
-            r.Set(j, (i == j ? T(1) : T(0)));
-        I.data.Set(i, r);
-    }
+    for (int i = 0; i < n; ++i)
+        I.data[i][i] = T(1);
     return solveSLAE(I);
 }
 
@@ -291,7 +302,7 @@ T Matrix<T>::getKNorm() const {
     for (int j = 0; j < m; ++j) {
         T s = T(0);
         for (int i = 0; i < n; ++i)
-            s += std::abs(data.Get(i).Get(j));
+            s += std::abs(data[i][j]);
         if (s > best) best = s;
     }
     return best;
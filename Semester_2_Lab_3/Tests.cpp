@@ -4,7 +4,10 @@
 #include "sequence.h"
 #include <cassert>
 #include <iostream>
-#include "Matrix_Mas.h"
+#include <string>
+#include <span>
+#include <cmath>
+#include "Matrix_MAS.h"
 
 
 void TestDynamicArray() {
@@ -16,6 +19,47 @@ void TestDynamicArray() {
     assert(arr.Get(1) == 2);
     assert(arr.Get(2) == 3);
     assert(arr.GetSize() == 3);
+
+    // Reserve не меняет размер, Resize дописывает T()
+    arr.Reserve(100);
+    assert(arr.GetSize() == 3 && arr.GetCapacity() == 100);
+    arr.Resize(5);
+    assert(arr.Get(3) == 0 && arr.Get(4) == 0);
+    assert(arr.Get(2) == 3);
+
+    // нетривиальный тип: EmplaceBack, Insert, перемещение
+    DynamicArray<std::string> words(0);
+    words.EmplaceBack(3, 'a');
+    words.PushBack("tail");
+    words.Insert(0, "head");
+    words.PushBack(words[0]);
+    assert(words.GetSize() == 4);
+    assert(words.Get(0) == "head" && words.Get(1) == "aaa");
+    assert(words.Get(2) == "tail" && words.Get(3) == "head");
+    words.PushBack(words[1]); // ссылка на собственный элемент в момент роста буфера
+    assert(words.GetSize() == 5 && words.Get(4) == "aaa");
+
+    DynamicArray<std::string> moved(std::move(words));
+    assert(moved.GetSize() == 5 && words.GetSize() == 0);
+    words = moved;
+    assert(words.GetSize() == 5 && words.Get(1) == "aaa");
+    moved.Resize(1);
+    assert(moved.GetSize() == 1 && moved.Get(0) == "head");
+
+    // малый буфер: 16 байт элементов живут в самом объекте и переносятся при перемещении
+    DynamicArray<char> row(0);
+    for (int i = 0; i < 16; i++) row.PushBack(static_cast<char>('a' + i));
+    assert(row.GetCapacity() == 16 && row.Get(15) == 'p');
+    DynamicArray<char> movedRow(std::move(row));
+    assert(movedRow.GetSize() == 16 && movedRow.Get(0) == 'a' && row.GetSize() == 0);
+    row.PushBack('z');
+    assert(row.Get(0) == 'z' && movedRow.Get(0) == 'a');
+    movedRow.PushBack('q'); // переполнение — переезд в кучу
+    assert(movedRow.GetSize() == 17 && movedRow.GetCapacity() > 16 && movedRow.Get(16) == 'q');
+    row = movedRow;
+    assert(row.GetSize() == 17 && row.Get(3) == 'd');
+    movedRow = DynamicArray<char>(0);
+    assert(movedRow.GetSize() == 0 && row.Get(16) == 'q');
     std::cout << "DynamicArray tests passed.\n";
 }
 
@@ -28,6 +72,13 @@ void TestLinkedList() {
     assert(list.GetFirst() == 1);
     assert(list.GetLast() == 3);
     assert(list.GetLength() == 3);
+
+    // итераторы
+    int sum = 0;
+    for (int x : list) sum += x;
+    assert(sum == 6);
+    for (int& x : list) x *= 10;
+    assert(list.Get(2) == 30);
     std::cout << "LinkedList tests passed.\n";
 }
 
@@ -40,21 +91,36 @@ void TestArraySequence() {
     assert(seq.GetLast() == 30);
     assert(seq.GetLength() == 3);
 
+    // Mutable: изменения на месте, возвращается this
     Sequence<int>* appended = seq.Append(20);
-    assert(appended->GetLength() == 4);
-    assert(appended->Get(3) == 20);
-    delete appended;
+    assert(appended == &seq);
+    assert(seq.GetLength() == 4);
+    assert(seq.Get(3) == 20);
 
     Sequence<int>* prepended = seq.Prepend(1);
-    assert(prepended->GetLength() == 4);
-    assert(prepended->Get(0) == 1);
-    delete prepended;
+    assert(prepended == &seq);
+    assert(seq.GetLength() == 5);
+    assert(seq.Get(0) == 1);
 
     Sequence<int>* inserted = seq.InsertAt(1, 99);
-    assert(inserted->GetLength() == 4);
-    assert(inserted->Get(1) == 99);
-    delete inserted;
+    assert(inserted == &seq);
+    assert(seq.GetLength() == 6);
+    assert(seq.Get(1) == 99);
+    assert(seq.Get(2) == 10);
+    assert(seq.Get(5) == 20);
 
+    // operator[] / UncheckedGet — ссылки на элементы, Get по-прежнему проверяет границы
+    seq[5] += 1;
+    seq.UncheckedGet(0) = 2;
+    assert(seq[5] == 21 && seq.Get(0) == 2);
+    seq[5] = 20;
+    seq[0] = 1;
+    bool thrown = false;
+    try { seq.Get(6); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+    (void)thrown;
+
+    // seq = {1, 99, 10, 15, 30, 20}
     Sequence<int>* sub = seq.GetSubsequence(0, 2);
     assert(sub->GetLength() == 3);
     delete sub;
@@ -62,10 +128,42 @@ void TestArraySequence() {
     int other[] = {40, 50};
     MutableArraySequence<int> otherSeq(other, 2);
     Sequence<int>* concat = seq.Concat(otherSeq);
-    assert(concat->GetLength() == 5);
-    assert(concat->Get(3) == 40);
+    assert(concat->GetLength() == 8);
+    assert(concat->Get(6) == 40);
     delete concat;
 
+    // Immutable: исходная последовательность не меняется
+    ImmutableArraySequence<int> imm(items, 3);
+    Sequence<int>* immAppended = imm.Append(20);
+    assert(immAppended != &imm);
+    assert(imm.GetLength() == 3);
+    assert(immAppended->GetLength() == 4);
+    assert(immAppended->Get(3) == 20);
+    delete immAppended;
+
+    // ArraySequence: итераторы произвольного доступа и курсор базового класса
+    MutableArraySequence<int> arr(items, 3);
+    assert(arr.end() - arr.begin() == 3);
+    assert(arr.begin()[2] == 30);
+    int total = 0;
+    for (int x : static_cast<const Sequence<int>&>(imm)) total += x;
+    assert(total == 55);
+
+    // непрерывный буфер: есть у массива, нет у списка и персистентного дерева
+    std::span<const int> span;
+    assert(static_cast<const Sequence<int>&>(arr).TryGetContiguous(span));
+    assert(span.size() == 3 && span[1] == 15 && span.data() == arr.AsSpan().data());
+    assert(!static_cast<const Sequence<int>&>(imm).TryGetContiguous(span));
+    MutableListSequence<int> list(items, 3);
+    assert(!static_cast<const Sequence<int>&>(list).TryGetContiguous(span));
+
+    // много Append подряд: ёмкость растёт геометрически
+    MutableArraySequence<int> big;
+    for (int i = 0; i < 10000; ++i) big.Append(i);
+    assert(big.GetLength() == 10000);
+    assert(big.Get(0) == 0);
+    assert(big.Get(9999) == 9999);
+
     std::cout << "ArraySequence tests passed.\n";
 }
 
@@ -78,20 +176,29 @@ void TestListSequence() {
     assert(seq.GetLast() == 3);
     assert(seq.GetLength() == 3);
 
-    Sequence<int>* appended = seq.Append(4);
-    assert(appended->GetLength() == 4);
-    assert(appended->Get(3) == 4);
-    delete appended;
+    // Mutable: изменяется сама последовательность, возвращается this
+    MutableListSequence<int> grown(items, 3);
+    Sequence<int>* appended = grown.Append(4);
+    assert(appended == &grown);
+    (void)appended;
+    assert(grown.GetLength() == 4 && grown.Get(3) == 4);
+
+    Sequence<int>* prepended = grown.Prepend(0);
+    assert(prepended == &grown);
+    (void)prepended;
+    assert(grown.GetLength() == 5 && grown.Get(0) == 0);
 
-    Sequence<int>* prepended = seq.Prepend(0);
-    assert(prepended->GetLength() == 4);
-    assert(prepended->Get(0) == 0);
-    delete prepended;
+    Sequence<int>* inserted = grown.InsertAt(2, 99);
+    assert(inserted == &grown);
+    (void)inserted;
+    assert(grown.GetLength() == 6 && grown.Get(2) == 99 && grown.Get(3) == 2);
+    assert(grown.GetLast() == 4);
 
-    Sequence<int>* inserted = seq.InsertAt(2, 99);
-    assert(inserted->GetLength() == 4);
-    assert(inserted->Get(2) == 99);
-    delete inserted;
+    // Immutable: исходный список не меняется
+    ImmutableListSequence<int> imm(items, 3);
+    Sequence<int>* immAppended = imm.Append(4);
+    assert(immAppended != &imm && imm.GetLength() == 3 && immAppended->Get(3) == 4);
+    delete immAppended;
 
     Sequence<int>* sub = seq.GetSubsequence(0, 2);
     assert(sub->GetLength() == 3);
@@ -104,6 +211,23 @@ void TestListSequence() {
     assert(concat->Get(4) == 6);
     delete concat;
 
+    // обход через базовый интерфейс: курсор/итератор/ForEach
+    const Sequence<int>& base = seq;
+    int expected = 1;
+    for (int x : base) {
+        (void)x;
+        assert(x == expected);
+        ++expected;
+    }
+    assert(expected == 4);
+    auto cursor = base.CreateCursor(1);
+    assert(cursor->IsValid() && cursor->Current() == 2);
+    cursor->Next(); cursor->Next();
+    assert(!cursor->IsValid());
+    int count = 0;
+    base.ForEach([&count](const int&) { ++count; });
+    assert(count == 3);
+
     std::cout << "ListSequence tests passed.\n";
 }
 
@@ -117,6 +241,33 @@ void TestMatrixIdentity() {
     Matrix<int> B = A.Transpose();
     assert(B.getKNorm() == 15);
 
+    // определитель и СЛАУ (строки читаются через AsSpan, без копий)
+    double sq[] = {2, 1, 1,
+                   1, 3, 2,
+                   1, 0, 0};
+    Matrix<double> S(3, 3, sq);
+    assert(std::fabs(S.determinant() - (-1.0)) < 1e-9);
+
+    double rhs[] = {4, 5, 6};
+    Matrix<double> x = S.solveSLAE(Matrix<double>(3, 1, rhs));
+    Matrix<double> check = S * x;
+    Matrix<double> expected(3, 1, rhs);
+    Matrix<double> diff = check + expected * (-1.0);
+    assert(diff.getKNorm() < 1e-9);
+
+    // элементарные преобразования меняют строки на месте
+    Matrix<int> C(2, 3, items);
+    C.SwapRows(0, 1);
+    C.SwapColumns(0, 2);
+    C.ScaleRow(0, 2);
+    C.addLinearCombination(0, 1, -1);
+    // C = {{12, 10, 8}, {-9, -8, -7}}
+    assert(C.getKNorm() == 21);
+    bool thrown = false;
+    try { C.SwapRows(0, 2); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+    (void)thrown;
+
     std::cout << "Matrix test passed.\n";
 }
 
@@ -80,8 +80,8 @@ static void run_repl() {
             int N; if (!(iss >> N) || N <= 0) { std::cout << "usage: bench N\n"; continue; }
             auto r1 = bench_raw_header_only(N);
             auto r2 = bench_shared_header_only(N);
-            std::cout << "raw:    N=" << r1.N << " ms=" << r1.ms << " rss=" << r1.rss << "\n";
-            std::cout << "shared: N=" << r2.N << " ms=" << r2.ms << " rss=" << r2.rss << "\n";
+            print_bench_header_only(r1);
+            print_bench_header_only(r2);
             write_csv_header_only(r1, r2);
 
         } else if (cmd == "leak") {
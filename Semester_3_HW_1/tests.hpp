@@ -3,19 +3,15 @@
 #include <chrono>
 #include <cstdint>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <string>
 
 #include "UnqPtr.hpp"
 #include "ShrdPtr.hpp"
 #include "Sequence.hpp"
-
-// ==== Платформенные инклюды (на верхнем уровне!) ====
-#if defined(__APPLE__)
-  #include <mach/mach.h>
-#elif defined(__linux__)
-  #include <sys/resource.h>
-#endif
+#include "AllocTracking.h"
+#include "ProcessMemory.h"
 
 // ==== Тестовые типы ====
 struct TestBase {
@@ -38,22 +34,9 @@ struct TestTracked {
     ~TestTracked(){ --alive; }
 };
 
-// ==== RSS (память процесса) ====
+// ==== RSS (память процесса, см. ProcessMemory.h) ====
 inline std::uint64_t tests_rss_bytes() {
-#if defined(__APPLE__)
-    mach_task_basic_info info;
-    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
-    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
-        return static_cast<std::uint64_t>(info.resident_size);
-    return 0;
-#elif defined(__linux__)
-    rusage ru{};
-    if (getrusage(RUSAGE_SELF, &ru) == 0)
-        return static_cast<std::uint64_t>(ru.ru_maxrss) * 1024ULL;
-    return 0;
-#else
-    return 0;
-#endif
+    return static_cast<std::uint64_t>(CurrentRssKB()) * 1024ULL;
 }
 
 // ==== Функциональные тесты (одиночные объекты) ====
@@ -132,11 +115,13 @@ inline void run_array_tests_header_only() {
     }
 }
 
-// ==== Бенчмарки (время + RSS) ====
-struct BenchResult { const char* variant; int N; long long ms; std::uint64_t rss; };
+// ==== Бенчмарки (время + RSS + выделения памяти) ====
+// allocs/peak_bytes ненулевые только в сборке с ALLOC_TRACKING (AllocTracking.h).
+struct BenchResult { const char* variant; int N; long long ms; std::uint64_t rss; std::uint64_t allocs; std::int64_t peak_bytes; };
 
 inline BenchResult bench_raw_header_only(int N) {
     using clock = std::chrono::high_resolution_clock;
+    AllocScope scope;
     auto t0 = clock::now();
     for (int i=0;i<N;++i) {
         TestTracked* p = new TestTracked(i);
@@ -144,11 +129,13 @@ inline BenchResult bench_raw_header_only(int N) {
         delete p;
     }
     auto t1 = clock::now();
-    return {"raw", N, std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count(), tests_rss_bytes()};
+    return {"raw", N, std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count(), tests_rss_bytes(),
+            scope.Allocations(), scope.PeakBytes()};
 }
 
 inline BenchResult bench_shared_header_only(int N) {
     using clock = std::chrono::high_resolution_clock;
+    AllocScope scope;
     auto t0 = clock::now();
     for (int i=0;i<N;++i) {
         UnqPtr<TestTracked> u(new TestTracked(i));
@@ -156,15 +143,25 @@ inline BenchResult bench_shared_header_only(int N) {
         { ShrdPtr<TestTracked> s2 = s; if (!s2) std::abort(); }
     }
     auto t1 = clock::now();
-    return {"shared", N, std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count(), tests_rss_bytes()};
+    return {"shared", N, std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count(), tests_rss_bytes(),
+            scope.Allocations(), scope.PeakBytes()};
+}
+
+inline void print_bench_header_only(const BenchResult& r) {
+    std::cout << std::left << std::setw(8) << (std::string(r.variant) + ":") << std::right
+              << "N=" << r.N << " ms=" << r.ms << " rss=" << r.rss;
+    if (AllocTrackingEnabled())
+        std::cout << " allocs=" << r.allocs << " (" << static_cast<double>(r.allocs) / r.N << "/iter)"
+                  << " peak=" << r.peak_bytes;
+    std::cout << "\n";
 }
 
 inline void write_csv_header_only(const BenchResult& a, const BenchResult& b, const std::string& path = "bench.csv") {
     std::ofstream f(path, std::ios::trunc);
     if (!f) return;
-    f << "variant,N,ms,rss_bytes\n";
-    f << a.variant << "," << a.N << "," << a.ms << "," << a.rss << "\n";
-    f << b.variant << "," << b.N << "," << b.ms << "," << b.rss << "\n";
+    f << "variant,N,ms,rss_bytes,allocs,peak_bytes\n";
+    f << a.variant << "," << a.N << "," << a.ms << "," << a.rss << "," << a.allocs << "," << a.peak_bytes << "\n";
+    f << b.variant << "," << b.N << "," << b.ms << "," << b.rss << "," << b.allocs << "," << b.peak_bytes << "\n";
 }
 
 // ==== Запуск всего комплекта ====
@@ -185,8 +182,8 @@ inline void run_all_tests_header_only(int N) {
     // Бенч
     BenchResult r1 = bench_raw_header_only(N);
     BenchResult r2 = bench_shared_header_only(N);
-    std::cout << "raw:    N=" << r1.N << " ms=" << r1.ms << " rss=" << r1.rss << "\n";
-    std::cout << "shared: N=" << r2.N << " ms=" << r2.ms << " rss=" << r2.rss << "\n";
+    print_bench_header_only(r1);
+    print_bench_header_only(r2);
     write_csv_header_only(r1, r2);
 
     std::cout << "All tests passed! (N=" << N << ")\n";
@@ -0,0 +1,262 @@
+#ifndef ASYNC_STREAMS_H
+#define ASYNC_STREAMS_H
+
+#include "dynamic_array.h"
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+// Чтение с упреждением: фоновый поток вызывает source.ReadBlock и складывает
+// готовые блоки в кольцо из blocks слотов, а потребитель забирает их, пока
+// фоновый поток уже читает и разбирает следующие. Так ввод-вывод и разбор
+// идут параллельно с обработкой (например, OnlineStatistics::AddRange).
+//
+// Source — любой поток с методом std::size_t ReadBlock(T*, std::size_t),
+// который возвращает меньше запрошенного только в конце: ReadOnlyStream,
+// BinaryReadOnlyStream. Пока жив AsyncReadOnlyStream, source читает только
+// его фоновый поток; source должен жить дольше.
+//
+// Кольцо — очередь один производитель / один потребитель без блокировок:
+// head (сколько слотов отдал потребитель) и tail (сколько заполнил
+// производитель) растут монотонно, слот i — i % blocks. Данные слота
+// публикуются release-записью tail и видны после acquire-чтения. Ждут
+// стороны только на пустой (потребитель) или полной (производитель)
+// очереди, через atomic::wait, и каждый такой случай считается.
+template<typename T, typename Source>
+class AsyncReadOnlyStream {
+public:
+    static constexpr int kDefaultBlocks = 4;
+    static constexpr std::size_t kDefaultBlockSize = 4096;
+
+    explicit AsyncReadOnlyStream(Source& source, int blocks = kDefaultBlocks, std::size_t blockSize = kDefaultBlockSize);
+    // Останавливает фоновый поток, даже если поток прочитан не до конца.
+    ~AsyncReadOnlyStream();
+
+    AsyncReadOnlyStream(const AsyncReadOnlyStream&) = delete;
+    AsyncReadOnlyStream& operator=(const AsyncReadOnlyStream&) = delete;
+
+    bool TryRead(T& value);
+    T Read();
+    std::size_t ReadBlock(T* out, std::size_t max);
+    // Следующий блок (или остаток текущего) без копирования: data
+    // действительна до следующего вызова любого метода чтения; false —
+    // конец потока. Исключение источника пробрасывается здесь (и в остальных
+    // методах чтения), когда потребитель доходит до места, где оно случилось.
+    bool NextBlock(const T*& data, std::size_t& count);
+
+    bool IsEndOfStream();
+    std::size_t GetPosition() const { return position; }
+
+    // Для подбора blocks и blockSize.
+    int GetCapacity() const { return blocks; }
+    // Готовых, ещё не взятых блоков (снимок).
+    std::size_t GetQueueDepth() const;
+    // Сколько раз потребитель ждал пустую очередь — производитель не успевает.
+    long long GetConsumerStalls() const { return consumerStalls.load(std::memory_order_relaxed); }
+    // Сколько раз производитель ждал полную очередь — не успевает потребитель.
+    long long GetProducerStalls() const { return producerStalls.load(std::memory_order_relaxed); }
+
+private:
+    Source& source;
+    int blocks;
+    std::size_t blockSize;
+    DynamicArray<T> storage;              // blocks * blockSize значений
+    DynamicArray<std::size_t> counts;     // заполнено в слоте; 0 — конец потока
+    std::exception_ptr error;             // пишется до публикации последнего слота
+
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+    std::atomic<bool> stopping;
+    std::atomic<long long> consumerStalls;
+    std::atomic<long long> producerStalls;
+
+    // состояние потребителя
+    const T* current;
+    std::size_t currentCount;
+    std::size_t currentIndex;
+    bool holding;                         // слот head взят и не возвращён
+    bool finished;
+    std::size_t position;
+
+    std::thread worker;
+
+    void produce();
+    bool acquire();
+    void release();
+};
+
+template<typename T, typename Source>
+AsyncReadOnlyStream<T, Source>::AsyncReadOnlyStream(Source& source, int blocks, std::size_t blockSize)
+    : source(source),
+      blocks(blocks),
+      blockSize(blockSize),
+      storage(0),
+      counts(0),
+      error(),
+      head(0),
+      tail(0),
+      stopping(false),
+      consumerStalls(0),
+      producerStalls(0),
+      current(nullptr),
+      currentCount(0),
+      currentIndex(0),
+      holding(false),
+      finished(false),
+      position(0)
+{
+    if (blocks < 2 || blockSize == 0) {
+        throw std::invalid_argument("need at least two blocks of positive size");
+    }
+    storage.Resize(static_cast<int>(blocks * blockSize));
+    counts.Resize(blocks);
+    worker = std::thread([this]() { produce(); });
+}
+
+template<typename T, typename Source>
+AsyncReadOnlyStream<T, Source>::~AsyncReadOnlyStream() {
+    stopping.store(true, std::memory_order_relaxed);
+    // разбудить производителя, если он ждёт места в очереди
+    head.fetch_add(1, std::memory_order_release);
+    head.notify_one();
+    worker.join();
+}
+
+template<typename T, typename Source>
+void AsyncReadOnlyStream<T, Source>::produce() {
+    std::size_t n = blocks;
+    bool ended = false;
+    for (std::size_t t = 0;; ++t) {
+        std::size_t h = head.load(std::memory_order_acquire);
+        if (t - h >= n && !stopping.load(std::memory_order_relaxed)) {
+            producerStalls.fetch_add(1, std::memory_order_relaxed);
+            do {
+                head.wait(h, std::memory_order_acquire);
+                h = head.load(std::memory_order_acquire);
+            } while (t - h >= n && !stopping.load(std::memory_order_relaxed));
+        }
+        if (stopping.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        // после неполного блока источник больше не читается: следующий
+        // слот — пустой, признак конца
+        std::size_t slot = t % n;
+        std::size_t got = 0;
+        if (!ended) {
+            try {
+                got = source.ReadBlock(storage.begin() + slot * blockSize, blockSize);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            ended = got < blockSize;
+        }
+        counts[static_cast<int>(slot)] = got;
+        tail.store(t + 1, std::memory_order_release);
+        tail.notify_one();
+        if (got == 0) {
+            return;
+        }
+    }
+}
+
+template<typename T, typename Source>
+bool AsyncReadOnlyStream<T, Source>::acquire() {
+    if (holding && currentIndex < currentCount) {
+        return true;
+    }
+    if (holding) {
+        release();
+    }
+    if (!finished) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        std::size_t t = tail.load(std::memory_order_acquire);
+        if (t == h) {
+            consumerStalls.fetch_add(1, std::memory_order_relaxed);
+            do {
+                tail.wait(t, std::memory_order_acquire);
+                t = tail.load(std::memory_order_acquire);
+            } while (t == h);
+        }
+        std::size_t slot = h % static_cast<std::size_t>(blocks);
+        currentCount = counts[static_cast<int>(slot)];
+        if (currentCount > 0) {
+            current = storage.begin() + slot * blockSize;
+            currentIndex = 0;
+            holding = true;
+            return true;
+        }
+        finished = true;    // слот-признак конца не возвращается: производитель уже вышел
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return false;
+}
+
+template<typename T, typename Source>
+void AsyncReadOnlyStream<T, Source>::release() {
+    holding = false;
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    head.notify_one();
+}
+
+template<typename T, typename Source>
+bool AsyncReadOnlyStream<T, Source>::TryRead(T& value) {
+    if (!acquire()) return false;
+    value = current[currentIndex++];
+    ++position;
+    return true;
+}
+
+template<typename T, typename Source>
+T AsyncReadOnlyStream<T, Source>::Read() {
+    T value{};
+    if (!TryRead(value)) {
+        throw std::runtime_error("end of stream");
+    }
+    return value;
+}
+
+template<typename T, typename Source>
+std::size_t AsyncReadOnlyStream<T, Source>::ReadBlock(T* out, std::size_t max) {
+    std::size_t done = 0;
+    while (done < max && acquire()) {
+        std::size_t take = currentCount - currentIndex;
+        if (take > max - done) take = max - done;
+        for (std::size_t i = 0; i < take; ++i) {
+            out[done + i] = current[currentIndex + i];
+        }
+        currentIndex += take;
+        done += take;
+    }
+    position += done;
+    return done;
+}
+
+template<typename T, typename Source>
+bool AsyncReadOnlyStream<T, Source>::NextBlock(const T*& data, std::size_t& count) {
+    if (!acquire()) return false;
+    data = current + currentIndex;
+    count = currentCount - currentIndex;
+    currentIndex = currentCount;
+    position += count;
+    return true;
+}
+
+template<typename T, typename Source>
+bool AsyncReadOnlyStream<T, Source>::IsEndOfStream() {
+    return !acquire();
+}
+
+template<typename T, typename Source>
+std::size_t AsyncReadOnlyStream<T, Source>::GetQueueDepth() const {
+    std::size_t t = tail.load(std::memory_order_acquire);
+    std::size_t h = head.load(std::memory_order_relaxed);
+    // взятый потребителем слот (или слот-признак конца) уже не в очереди
+    return t - h - (holding || finished ? 1 : 0);
+}
+
+#endif
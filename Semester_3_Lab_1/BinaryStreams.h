@@ -0,0 +1,514 @@
+#ifndef BINARY_STREAMS_H
+#define BINARY_STREAMS_H
+
+#include "dynamic_array.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Двоичный формат для столбца чисел одного типа T (целые или с плавающей
+// точкой), вместо текста с разбором на каждом чтении.
+//
+//   заголовок, 24 байта:
+//     0  "PBIN"           — сигнатура
+//     4  u8  версия (1)
+//     5  u8  вид: 'i' знаковое, 'u' беззнаковое, 'f' с плавающей точкой
+//     6  u8  sizeof(T)
+//     7  u8  флаги: 1 — у блоков есть итоги
+//     8  u32 элементов в блоке
+//     12 u32 0
+//     16 u64 всего элементов
+//   затем блоки: blockSize значений (последний — сколько осталось), и если
+//   включены итоги, после каждого блока — min, max (по sizeof(T)) и сумма
+//   (8 байт, BinaryBlockSummary<T>::SumType).
+//
+// Все числа — little-endian фиксированной ширины, так что на little-endian
+// машине блок читается и пишется одним read/write без преобразований.
+// Число элементов дописывается в заголовок при Close, поэтому выход должен
+// поддерживать seekp (файл, stringstream).
+
+template<typename T>
+struct BinaryBlockSummary {
+    using SumType = std::conditional_t<std::is_floating_point_v<T>, double,
+                    std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+    std::size_t count = 0;
+    T min{};
+    T max{};
+    SumType sum{};
+};
+
+namespace binary_format {
+
+    constexpr char kMagic[4] = {'P', 'B', 'I', 'N'};
+    constexpr std::uint8_t kVersion = 1;
+    constexpr std::uint8_t kFlagSummaries = 1;
+    constexpr std::size_t kHeaderSize = 24;
+
+    template<typename T>
+    constexpr char KindOf() {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                      "binary streams store integer or floating-point values");
+        static_assert(std::is_floating_point_v<T> ? std::numeric_limits<T>::is_iec559 : true,
+                      "floating-point values are stored as IEEE 754");
+        return std::is_floating_point_v<T> ? 'f' : std::is_signed_v<T> ? 'i' : 'u';
+    }
+
+    template<typename T>
+    std::size_t SummarySize() {
+        return 2 * sizeof(T) + sizeof(typename BinaryBlockSummary<T>::SumType);
+    }
+
+    // Порядок байт значения переворачивается только на big-endian машине.
+    template<typename T>
+    T ToLittleEndian(T value) {
+        if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+            return value;
+        } else {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            for (std::size_t i = 0; i < sizeof(T) / 2; ++i) {
+                unsigned char tmp = bytes[i];
+                bytes[i] = bytes[sizeof(T) - 1 - i];
+                bytes[sizeof(T) - 1 - i] = tmp;
+            }
+            std::memcpy(&value, bytes, sizeof(T));
+            return value;
+        }
+    }
+
+    template<typename T>
+    void Store(char* out, T value) {
+        value = ToLittleEndian(value);
+        std::memcpy(out, &value, sizeof(T));
+    }
+
+    template<typename T>
+    T Load(const char* in) {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        return ToLittleEndian(value);
+    }
+
+}
+
+// ------------------------ BinaryWriteOnlyStream ------------------------
+
+template<typename T>
+class BinaryWriteOnlyStream {
+public:
+    static constexpr int kDefaultBlockSize = 4096;
+
+    // Поток должен поддерживать seekp: при Close в заголовок пишется число элементов.
+    BinaryWriteOnlyStream(std::ostream& output, int blockSize = kDefaultBlockSize, bool blockSummaries = true);
+    BinaryWriteOnlyStream(const std::string& fileName, int blockSize = kDefaultBlockSize, bool blockSummaries = true);
+    ~BinaryWriteOnlyStream();
+
+    BinaryWriteOnlyStream(const BinaryWriteOnlyStream<T>&) = delete;
+    BinaryWriteOnlyStream<T>& operator=(const BinaryWriteOnlyStream<T>&) = delete;
+
+    void Write(const T& value);
+    // Полные блоки из values пишутся напрямую, без копии в буфер.
+    void WriteBlock(const T* values, std::size_t count);
+    // Дописать неполный блок и число элементов; после Close писать нельзя.
+    void Close();
+
+    std::size_t GetPosition() const { return position; }
+
+private:
+    std::ostream* out;
+    std::ofstream* ownedStream;
+    int blockSize;
+    bool summaries;
+    std::streampos headerAt;
+    DynamicArray<T> pending;     // начатый блок
+    int pendingCount;
+    DynamicArray<char> scratch;  // big-endian машина: блок в порядке файла
+    std::size_t position;
+    bool opened;
+
+    void start(int blockSize);
+    void writeBlock(const T* values, std::size_t count);
+    void check() const;
+};
+
+template<typename T>
+BinaryWriteOnlyStream<T>::BinaryWriteOnlyStream(std::ostream& output, int blockSize, bool blockSummaries)
+    : out(&output),
+      ownedStream(nullptr),
+      blockSize(0),
+      summaries(blockSummaries),
+      headerAt(),
+      pending(0),
+      pendingCount(0),
+      scratch(0),
+      position(0),
+      opened(false)
+{
+    start(blockSize);
+}
+
+template<typename T>
+BinaryWriteOnlyStream<T>::BinaryWriteOnlyStream(const std::string& fileName, int blockSize, bool blockSummaries)
+    : out(nullptr),
+      ownedStream(new std::ofstream(fileName, std::ios::binary | std::ios::trunc)),
+      blockSize(0),
+      summaries(blockSummaries),
+      headerAt(),
+      pending(0),
+      pendingCount(0),
+      scratch(0),
+      position(0),
+      opened(false)
+{
+    if (!ownedStream->is_open()) {
+        delete ownedStream;
+        ownedStream = nullptr;
+        throw std::runtime_error("cannot open file");
+    }
+    out = ownedStream;
+    try {
+        start(blockSize);
+    } catch (...) {
+        delete ownedStream;
+        throw;
+    }
+}
+
+template<typename T>
+BinaryWriteOnlyStream<T>::~BinaryWriteOnlyStream() {
+    try {
+        Close();
+    } catch (...) {
+        // ошибка записи в деструкторе не пробрасывается; нужна — вызывайте Close
+    }
+    delete ownedStream;
+}
+
+template<typename T>
+void BinaryWriteOnlyStream<T>::start(int size) {
+    if (size <= 0) {
+        throw std::invalid_argument("block size must be positive");
+    }
+    blockSize = size;
+    headerAt = out->tellp();
+    if (headerAt == std::streampos(-1)) {
+        throw std::runtime_error("binary stream needs a seekable output");
+    }
+    char header[binary_format::kHeaderSize] = {};
+    std::memcpy(header, binary_format::kMagic, 4);
+    header[4] = static_cast<char>(binary_format::kVersion);
+    header[5] = binary_format::KindOf<T>();
+    header[6] = static_cast<char>(sizeof(T));
+    header[7] = static_cast<char>(summaries ? binary_format::kFlagSummaries : 0);
+    binary_format::Store<std::uint32_t>(header + 8, static_cast<std::uint32_t>(blockSize));
+    out->write(header, sizeof(header));
+    pending.Resize(blockSize);
+    opened = true;
+}
+
+template<typename T>
+void BinaryWriteOnlyStream<T>::check() const {
+    if (!opened || !out) {
+        throw std::runtime_error("stream is not open for writing");
+    }
+}
+
+template<typename T>
+void BinaryWriteOnlyStream<T>::Write(const T& value) {
+    check();
+    pending[pendingCount++] = value;
+    ++position;
+    if (pendingCount == blockSize) {
+        writeBlock(pending.begin(), static_cast<std::size_t>(blockSize));
+        pendingCount = 0;
+    }
+}
+
+template<typename T>
+void BinaryWriteOnlyStream<T>::WriteBlock(const T* values, std::size_t count) {
+    check();
+    std::size_t done = 0;
+    // сначала добить начатый блок
+    while (pendingCount > 0 && done < count) {
+        Write(values[done++]);
+    }
+    for (; count - done >= static_cast<std::size_t>(blockSize); done += blockSize) {
+        writeBlock(values + done, static_cast<std::size_t>(blockSize));
+        position += blockSize;
+    }
+    while (done < count) {
+        Write(values[done++]);
+    }
+}
+
+template<typename T>
+void BinaryWriteOnlyStream<T>::writeBlock(const T* values, std::size_t count) {
+    if constexpr (std::endian::native == std::endian::little) {
+        out->write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+    } else {
+        scratch.Resize(static_cast<int>(count * sizeof(T)));
+        for (std::size_t i = 0; i < count; ++i) {
+            binary_format::Store(scratch.begin() + i * sizeof(T), values[i]);
+        }
+        out->write(scratch.begin(), static_cast<std::streamsize>(count * sizeof(T)));
+    }
+    if (summaries) {
+        using SumType = typename BinaryBlockSummary<T>::SumType;
+        T lo = values[0], hi = values[0];
+        SumType sum{};
+        for (std::size_t i = 0; i < count; ++i) {
+            if (values[i] < lo) lo = values[i];
+            if (values[i] > hi) hi = values[i];
+            sum += static_cast<SumType>(values[i]);
+        }
+        char footer[2 * sizeof(T) + sizeof(SumType)];
+        binary_format::Store(footer, lo);
+        binary_format::Store(footer + sizeof(T), hi);
+        binary_format::Store(footer + 2 * sizeof(T), sum);
+        out->write(footer, sizeof(footer));
+    }
+    if (!*out) {
+        throw std::runtime_error("cannot write binary stream");
+    }
+}
+
+template<typename T>
+void BinaryWriteOnlyStream<T>::Close() {
+    if (!opened) return;
+    opened = false;
+    if (pendingCount > 0) {
+        writeBlock(pending.begin(), static_cast<std::size_t>(pendingCount));
+        pendingCount = 0;
+    }
+    std::streampos end = out->tellp();
+    char count[8];
+    binary_format::Store<std::uint64_t>(count, static_cast<std::uint64_t>(position));
+    out->seekp(headerAt + std::streamoff(16));
+    out->write(count, sizeof(count));
+    out->seekp(end);
+    if (ownedStream) {
+        ownedStream->close();
+    }
+    if (!*out) {
+        throw std::runtime_error("cannot write binary stream");
+    }
+}
+
+// ------------------------ BinaryReadOnlyStream ------------------------
+
+template<typename T>
+class BinaryReadOnlyStream {
+public:
+    explicit BinaryReadOnlyStream(std::istream& input);
+    explicit BinaryReadOnlyStream(const std::string& fileName);
+    ~BinaryReadOnlyStream();
+
+    BinaryReadOnlyStream(const BinaryReadOnlyStream<T>&) = delete;
+    BinaryReadOnlyStream<T>& operator=(const BinaryReadOnlyStream<T>&) = delete;
+
+    std::size_t GetCount() const { return count; }
+    std::size_t GetPosition() const { return position; }
+    int GetBlockSize() const { return blockSize; }
+    bool HasBlockSummaries() const { return summaries; }
+    bool IsEndOfStream() const { return position >= count; }
+
+    T Read();
+    bool TryRead(T& value);
+    // До max значений; меньше — только в конце потока.
+    std::size_t ReadBlock(T* out, std::size_t max);
+
+    // Итоги блока, который начинается в текущей позиции (позиция должна быть
+    // на границе блока, а в файле — включены итоги). Ничего не читает из
+    // значений: вход перематывается к итогам и обратно, поэтому нужен seekg.
+    bool PeekBlockSummary(BinaryBlockSummary<T>& summary);
+    // Перескочить оставшиеся значения текущего блока.
+    void SkipBlock();
+
+private:
+    std::istream* in;
+    std::ifstream* ownedStream;
+    int blockSize;
+    bool summaries;
+    std::size_t count;
+    std::size_t position;
+    std::size_t leftInBlock;     // значений текущего блока ещё не прочитано
+    bool footerPending;          // значения блока прочитаны, итоги — нет
+
+    void readHeader();
+    void enterBlock();
+    void readExact(char* out, std::size_t bytes);
+};
+
+template<typename T>
+BinaryReadOnlyStream<T>::BinaryReadOnlyStream(std::istream& input)
+    : in(&input),
+      ownedStream(nullptr),
+      blockSize(0),
+      summaries(false),
+      count(0),
+      position(0),
+      leftInBlock(0),
+      footerPending(false)
+{
+    readHeader();
+}
+
+template<typename T>
+BinaryReadOnlyStream<T>::BinaryReadOnlyStream(const std::string& fileName)
+    : in(nullptr),
+      ownedStream(new std::ifstream(fileName, std::ios::binary)),
+      blockSize(0),
+      summaries(false),
+      count(0),
+      position(0),
+      leftInBlock(0),
+      footerPending(false)
+{
+    if (!ownedStream->is_open()) {
+        delete ownedStream;
+        ownedStream = nullptr;
+        throw std::runtime_error("cannot open file");
+    }
+    in = ownedStream;
+    try {
+        readHeader();
+    } catch (...) {
+        delete ownedStream;
+        throw;
+    }
+}
+
+template<typename T>
+BinaryReadOnlyStream<T>::~BinaryReadOnlyStream() {
+    delete ownedStream;
+}
+
+template<typename T>
+void BinaryReadOnlyStream<T>::readExact(char* out, std::size_t bytes) {
+    in->read(out, static_cast<std::streamsize>(bytes));
+    if (static_cast<std::size_t>(in->gcount()) != bytes) {
+        throw std::runtime_error("binary stream is truncated");
+    }
+}
+
+template<typename T>
+void BinaryReadOnlyStream<T>::readHeader() {
+    char header[binary_format::kHeaderSize];
+    readExact(header, sizeof(header));
+    if (std::memcmp(header, binary_format::kMagic, 4) != 0 ||
+        static_cast<std::uint8_t>(header[4]) != binary_format::kVersion) {
+        throw std::runtime_error("not a binary stream");
+    }
+    if (header[5] != binary_format::KindOf<T>() || static_cast<std::size_t>(header[6]) != sizeof(T)) {
+        throw std::runtime_error("binary stream holds a different element type");
+    }
+    summaries = (header[7] & binary_format::kFlagSummaries) != 0;
+    std::uint32_t size = binary_format::Load<std::uint32_t>(header + 8);
+    if (size == 0 || size > static_cast<std::uint32_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("bad block size in binary stream");
+    }
+    blockSize = static_cast<int>(size);
+    count = static_cast<std::size_t>(binary_format::Load<std::uint64_t>(header + 16));
+}
+
+// Перейти к следующему блоку: пропустить итоги прочитанного.
+template<typename T>
+void BinaryReadOnlyStream<T>::enterBlock() {
+    if (footerPending) {
+        in->ignore(static_cast<std::streamsize>(binary_format::SummarySize<T>()));
+        footerPending = false;
+    }
+    std::size_t left = count - position;
+    leftInBlock = left < static_cast<std::size_t>(blockSize) ? left : static_cast<std::size_t>(blockSize);
+}
+
+template<typename T>
+std::size_t BinaryReadOnlyStream<T>::ReadBlock(T* out, std::size_t max) {
+    std::size_t done = 0;
+    while (done < max && position < count) {
+        if (leftInBlock == 0) {
+            enterBlock();
+        }
+        std::size_t take = max - done < leftInBlock ? max - done : leftInBlock;
+        readExact(reinterpret_cast<char*>(out + done), take * sizeof(T));
+        if constexpr (std::endian::native != std::endian::little) {
+            for (std::size_t i = 0; i < take; ++i) out[done + i] = binary_format::ToLittleEndian(out[done + i]);
+        }
+        done += take;
+        position += take;
+        leftInBlock -= take;
+        footerPending = summaries && leftInBlock == 0;
+    }
+    return done;
+}
+
+template<typename T>
+bool BinaryReadOnlyStream<T>::TryRead(T& value) {
+    return ReadBlock(&value, 1) == 1;
+}
+
+template<typename T>
+T BinaryReadOnlyStream<T>::Read() {
+    T value{};
+    if (!TryRead(value)) {
+        throw std::runtime_error("end of stream");
+    }
+    return value;
+}
+
+template<typename T>
+bool BinaryReadOnlyStream<T>::PeekBlockSummary(BinaryBlockSummary<T>& summary) {
+    if (!summaries) {
+        throw std::logic_error("binary stream has no block summaries");
+    }
+    if (position >= count) {
+        return false;
+    }
+    // все блоки, кроме последнего, полные — граница блока кратна blockSize
+    if (position % static_cast<std::size_t>(blockSize) != 0) {
+        throw std::logic_error("position is not at a block boundary");
+    }
+    if (leftInBlock == 0) {
+        enterBlock();
+    }
+    std::streampos here = in->tellg();
+    in->seekg(static_cast<std::streamoff>(leftInBlock * sizeof(T)), std::ios::cur);
+    char footer[2 * sizeof(T) + sizeof(typename BinaryBlockSummary<T>::SumType)];
+    readExact(footer, sizeof(footer));
+    in->seekg(here);
+    if (!*in) {
+        throw std::runtime_error("binary stream is not seekable");
+    }
+    summary.count = leftInBlock;
+    summary.min = binary_format::Load<T>(footer);
+    summary.max = binary_format::Load<T>(footer + sizeof(T));
+    summary.sum = binary_format::Load<typename BinaryBlockSummary<T>::SumType>(footer + 2 * sizeof(T));
+    return true;
+}
+
+template<typename T>
+void BinaryReadOnlyStream<T>::SkipBlock() {
+    if (position >= count) {
+        return;
+    }
+    if (leftInBlock == 0) {
+        enterBlock();
+    }
+    in->seekg(static_cast<std::streamoff>(leftInBlock * sizeof(T)), std::ios::cur);
+    if (!*in) {
+        throw std::runtime_error("binary stream is not seekable");
+    }
+    position += leftInBlock;
+    leftInBlock = 0;
+    footerPending = summaries;
+}
+
+#endif
@@ -0,0 +1,275 @@
+#ifndef LAZY_PIPELINE_H
+#define LAZY_PIPELINE_H
+
+#include "sequence.h"
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Ленивый конвейер над последовательностями: Map / Where / Zip / Take / Skip
+// строят цепочку узлов-выражений, а Reduce / ForEach / AddTo / Count / ToArraySequence
+// прогоняют её за один проход, без промежуточных массивов.
+//
+//     auto sum = PipelineFrom(seq).Where(isEven).Map(square).Take(1000)
+//                    .Reduce(0LL, [](long long a, int x) { return a + x; });
+//     PipelineFrom(readings).Skip(10).AddTo(stats);
+//
+// Каждый узел — шаблон от типа предыдущего узла и типа лямбды, поэтому весь
+// конвейер — один конкретный тип и компилятор встраивает лямбды (в отличие от
+// std::function в LazySequence). Узел умеет одно: bool Next(V& out) — выдать
+// следующее значение или сообщить о конце.
+//
+// Конвейер хранит ссылки на исходные последовательности — они должны жить
+// дольше него. Терминальные операции работают с копией узлов, так что один
+// конвейер можно прогнать несколько раз.
+
+template<typename Node>
+class Pipeline;
+
+// ------------------------ Источник ------------------------
+
+// Элементы последовательности по порядку. Для LazySequence берётся GetAt
+// (годится и для неограниченной), невиртуальный вызов.
+template<typename Seq>
+class SequenceSource {
+public:
+    using value_type = std::decay_t<decltype(std::declval<const Seq&>().Get(0))>;
+
+    explicit SequenceSource(const Seq& seq) : seq(&seq), position(0), end(lengthOf(seq)) {}
+
+    bool Next(value_type& out) {
+        if (position >= end) return false;
+        out = get(position++);
+        return true;
+    }
+
+    // Пропуск без чтения элементов (для Skip).
+    void Advance(long long n) {
+        position = n > end - position ? end : position + n;
+    }
+
+private:
+    const Seq* seq;
+    long long position;
+    long long end;
+
+    static long long lengthOf(const Seq& s) {
+        if constexpr (requires { s.IsUnbounded(); }) {
+            if (s.IsUnbounded()) return std::numeric_limits<long long>::max();
+        }
+        return s.GetLength();
+    }
+
+    value_type get(long long index) const {
+        if constexpr (requires { seq->GetAt(index); }) {
+            return seq->GetAt(index);
+        } else {
+            return seq->Get(static_cast<int>(index));
+        }
+    }
+};
+
+// ------------------------ Узлы ------------------------
+
+template<typename Src, typename F>
+class MapNode {
+public:
+    using source_type = typename Src::value_type;
+    using value_type = std::decay_t<std::invoke_result_t<F&, const source_type&>>;
+
+    MapNode(Src src, F f) : src(std::move(src)), f(std::move(f)) {}
+
+    bool Next(value_type& out) {
+        source_type value;
+        if (!src.Next(value)) return false;
+        out = f(value);
+        return true;
+    }
+
+private:
+    Src src;
+    F f;
+};
+
+template<typename Src, typename P>
+class WhereNode {
+public:
+    using value_type = typename Src::value_type;
+
+    WhereNode(Src src, P predicate) : src(std::move(src)), predicate(std::move(predicate)) {}
+
+    bool Next(value_type& out) {
+        while (src.Next(out)) {
+            if (predicate(out)) return true;
+        }
+        return false;
+    }
+
+private:
+    Src src;
+    P predicate;
+};
+
+template<typename A, typename B, typename F>
+class ZipNode {
+public:
+    using first_type = typename A::value_type;
+    using second_type = typename B::value_type;
+    using value_type = std::decay_t<std::invoke_result_t<F&, const first_type&, const second_type&>>;
+
+    ZipNode(A a, B b, F f) : a(std::move(a)), b(std::move(b)), f(std::move(f)) {}
+
+    // Заканчивается вместе с более коротким входом.
+    bool Next(value_type& out) {
+        first_type x;
+        second_type y;
+        if (!a.Next(x) || !b.Next(y)) return false;
+        out = f(x, y);
+        return true;
+    }
+
+private:
+    A a;
+    B b;
+    F f;
+};
+
+template<typename Src>
+class TakeNode {
+public:
+    using value_type = typename Src::value_type;
+
+    TakeNode(Src src, long long count) : src(std::move(src)), left(count) {}
+
+    bool Next(value_type& out) {
+        if (left <= 0 || !src.Next(out)) return false;
+        --left;
+        return true;
+    }
+
+private:
+    Src src;
+    long long left;
+};
+
+template<typename Src>
+class SkipNode {
+public:
+    using value_type = typename Src::value_type;
+
+    SkipNode(Src src, long long count) : src(std::move(src)), toSkip(count) {}
+
+    // Пропуск откладывается до первого Next; источник-последовательность
+    // перескакивает индексы, не вычисляя элементы.
+    bool Next(value_type& out) {
+        if (toSkip > 0) {
+            if constexpr (requires { this->src.Advance(toSkip); }) {
+                src.Advance(toSkip);
+            } else {
+                value_type skipped;
+                for (long long i = 0; i < toSkip; ++i) {
+                    if (!src.Next(skipped)) break;
+                }
+            }
+            toSkip = 0;
+        }
+        return src.Next(out);
+    }
+
+private:
+    Src src;
+    long long toSkip;
+};
+
+// ------------------------ Конвейер ------------------------
+
+template<typename Node>
+class Pipeline {
+public:
+    using value_type = typename Node::value_type;
+
+    explicit Pipeline(Node node) : node(std::move(node)) {}
+
+    template<typename F>
+    auto Map(F f) const {
+        return Pipeline<MapNode<Node, F>>(MapNode<Node, F>(node, std::move(f)));
+    }
+
+    template<typename P>
+    auto Where(P predicate) const {
+        return Pipeline<WhereNode<Node, P>>(WhereNode<Node, P>(node, std::move(predicate)));
+    }
+
+    template<typename Other, typename F>
+    auto Zip(const Pipeline<Other>& other, F f) const {
+        return Pipeline<ZipNode<Node, Other, F>>(ZipNode<Node, Other, F>(node, other.node, std::move(f)));
+    }
+
+    // Пары (x, y).
+    template<typename Other>
+    auto Zip(const Pipeline<Other>& other) const {
+        return Zip(other, [](const value_type& x, const typename Other::value_type& y) {
+            return std::pair<value_type, typename Other::value_type>(x, y);
+        });
+    }
+
+    auto Take(long long count) const {
+        if (count < 0) throw std::invalid_argument("count must be non-negative");
+        return Pipeline<TakeNode<Node>>(TakeNode<Node>(node, count));
+    }
+
+    auto Skip(long long count) const {
+        if (count < 0) throw std::invalid_argument("count must be non-negative");
+        return Pipeline<SkipNode<Node>>(SkipNode<Node>(node, count));
+    }
+
+    // ---- терминальные операции ----
+
+    template<typename Acc, typename F>
+    Acc Reduce(Acc init, F f) const {
+        Node run = node;
+        value_type value;
+        while (run.Next(value)) init = f(std::move(init), value);
+        return init;
+    }
+
+    template<typename F>
+    void ForEach(F f) const {
+        Node run = node;
+        value_type value;
+        while (run.Next(value)) f(value);
+    }
+
+    // Передать все значения в накопитель с методом Add (OnlineStatistics, IStatistic).
+    template<typename Sink>
+    Sink& AddTo(Sink& sink) const {
+        ForEach([&sink](const value_type& value) { sink.Add(value); });
+        return sink;
+    }
+
+    long long Count() const {
+        return Reduce(0LL, [](long long n, const value_type&) { return n + 1; });
+    }
+
+    // Единственное место, где конвейер что-то материализует. Для бесконечного
+    // источника нужен Take.
+    MutableArraySequence<value_type>* ToArraySequence() const {
+        auto* result = new MutableArraySequence<value_type>();
+        ForEach([result](const value_type& value) { result->Append(value); });
+        return result;
+    }
+
+private:
+    template<typename>
+    friend class Pipeline;
+
+    Node node;
+};
+
+template<typename Seq>
+Pipeline<SequenceSource<Seq>> PipelineFrom(const Seq& seq) {
+    return Pipeline<SequenceSource<Seq>>(SequenceSource<Seq>(seq));
+}
+
+#endif
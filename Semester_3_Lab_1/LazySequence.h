@@ -2,21 +2,89 @@
 #define LAZY_SEQUENCE_H
 
 #include "sequence.h"
+#include "BlockCache.h"
+#include "LazyPipeline.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <limits>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
 
+// Генератор бывает двух видов:
+//  * поэлементный T(seq, i) — вызывается для каждого индекса по порядку и может
+//    читать уже сгенерированные элементы через seq.Get(j), j < i;
+//  * блочный void(seq, start, out, count) — заполняет out[0..count) значениями
+//    элементов start..start+count-1 за один вызов. Элементы до start доступны
+//    через seq.Get, элементы текущего блока — через сам out.
+// Блочный генератор материализует последовательность блоками по blockSize
+// (не больше длины), поэлементный работает через адаптер к блочному и
+// генерирует ровно запрошенный префикс. Массив под префикс растёт по мере
+// материализации, а не выделяется сразу на всю длину.
+//
+// Режим Access::Random — для генераторов, которые не читают другие элементы
+// (замкнутая формула от индекса). Get(i) генерирует только блок, содержащий i,
+// и кладёт его в LRU-кэш (BlockCache) из cacheBlocks блоков: память
+// пропорциональна тронутому, а не длине, и Get(10^9 - 1) — один вызов
+// генератора. Вытесненный блок при следующем обращении генерируется заново.
+//
+// Режим Access::Indexed — префикс, как в Sequential, но генератор помечен как
+// зависящий только от индекса (чистый и потокобезопасный). Тогда блоки можно
+// считать в любом порядке, и MaterializeParallel заполняет префикс несколькими
+// потоками. Для остальных генераторов MaterializeParallel последователен.
+//
+// Неограниченный режим (Unbounded{window}) — бесконечная последовательность,
+// например поток показаний датчика. Генератор может заглядывать назад не дальше
+// чем на window элементов; элементы хранятся в кольцевом буфере размером
+// ~window + blockSize, более старые затираются, так что память постоянна при
+// любом числе шагов. Индексы здесь выходят за int — для них есть GetAt(long long);
+// GetLength() возвращает INT_MAX, а обращение к вытесненному элементу —
+// std::out_of_range.
 template<typename T>
 class LazySequence : public Sequence<T> {
 public:
+    using Generator = std::function<T(const LazySequence<T>&, long long)>;
+    using BatchGenerator = std::function<void(const LazySequence<T>&, long long start, T* out, int count)>;
+
+    enum class Access { Sequential, Random, Indexed };
+
+    // Бесконечная длина; window — на сколько элементов генератор смотрит назад.
+    struct Unbounded {
+        int window;
+    };
+
+    static constexpr int kDefaultBlockSize = 4096;
+    static constexpr int kRandomBlockSize = 64;
+    static constexpr int kDefaultCacheBlocks = 1024;
+    static constexpr int kMinRingChunk = 64;
+    static constexpr int kParallelChunk = 1 << 15;
+
     LazySequence();
     LazySequence(T* data, int count);
     LazySequence(const Sequence<T>& other);
     LazySequence(const LazySequence<T>& other);
     LazySequence<T>& operator=(const LazySequence<T>& other);
     ~LazySequence();
-    LazySequence(std::function<T(const LazySequence<T>&, int)> generator, int length);
+    LazySequence(Generator generator, int length);
+    LazySequence(BatchGenerator generator, int length, int blockSize = kDefaultBlockSize);
+    // Access::Sequential / Indexed — материализация префикса, как выше (blockSize —
+    // размер блока генерации, cacheBlocks не используется).
+    LazySequence(Generator generator, int length, Access access,
+                 int blockSize = kRandomBlockSize, int cacheBlocks = kDefaultCacheBlocks);
+    LazySequence(BatchGenerator generator, int length, Access access,
+                 int blockSize = kRandomBlockSize, int cacheBlocks = kDefaultCacheBlocks);
+    LazySequence(Generator generator, Unbounded unbounded);
+    LazySequence(BatchGenerator generator, Unbounded unbounded, int blockSize = kDefaultBlockSize);
 
     T Get(int index) const override;
+    // Get для индексов неограниченной последовательности.
+    T GetAt(long long index) const;
     int GetLength() const override;
     T GetFirst() const override;
     T GetLast() const override;
@@ -31,16 +99,86 @@ public:
     Sequence<T>* Instance() const override;
     Sequence<T>* Clone() const override;
 
-    int GetMaterializedCount() const { return materializedCount; }
+    // Ленивые комбинаторы: то же, что PipelineFrom(*this).Map(f) и т.д.
+    // (LazyPipeline.h). Ничего не вычисляют до терминальной операции.
+    template<typename F>
+    auto Map(F f) const { return PipelineFrom(*this).Map(std::move(f)); }
+    template<typename P>
+    auto Where(P predicate) const { return PipelineFrom(*this).Where(std::move(predicate)); }
+    template<typename Other, typename F>
+    auto Zip(const Pipeline<Other>& other, F f) const { return PipelineFrom(*this).Zip(other, std::move(f)); }
+    template<typename U, typename F>
+    auto Zip(const LazySequence<U>& other, F f) const { return Zip(PipelineFrom(other), std::move(f)); }
+    auto Take(long long count) const { return PipelineFrom(*this).Take(count); }
+    auto Skip(long long count) const { return PipelineFrom(*this).Skip(count); }
+    template<typename Acc, typename F>
+    Acc Reduce(Acc init, F f) const { return PipelineFrom(*this).Reduce(std::move(init), std::move(f)); }
+
+    // Длина материализованного префикса (в режиме Random всегда 0).
+    long long GetMaterializedCount() const {
+        return concurrent ? watermark.load(std::memory_order_acquire) : materializedCount;
+    }
+    bool IsUnbounded() const { return ringMask != 0; }
+    // Самый старый индекс, который ещё хранится (0 вне неограниченного режима).
+    long long GetOldestRetained() const;
+    Access GetAccess() const { return cache ? Access::Random : indexed ? Access::Indexed : Access::Sequential; }
+
+    // Блоков в кэше режима Random.
+    int GetCachedBlocks() const { return cache ? cache->GetCachedBlocks() : 0; }
+
+    // Материализовать префикс [0, upto) потоками threads (0 — по числу ядер).
+    // Параллельно только в режиме Indexed: диапазон режется на куски по
+    // kParallelChunk, потоки разбирают их по атомарному счётчику и пишут прямо
+    // в массив префикса. Исключение генератора пробрасывается после остановки
+    // всех потоков, префикс при этом не растёт.
+    void MaterializeParallel(int upto, int threads = 0) const;
+
+    // Разрешить чтение из нескольких потоков (Sequential / Indexed). Вызывается
+    // до того, как последовательность станет общей. Массив префикса сразу
+    // резервируется на всю длину и больше не переезжает; готовый префикс
+    // публикуется атомарной отметкой (release/acquire), и чтение ниже неё идёт
+    // без блокировок. Поток, забежавший вперёд, либо сам становится
+    // единственным производителем и достраивает блоки, публикуя отметку после
+    // каждого, либо ждёт (atomic::wait), пока отметка его не обгонит.
+    // Копия последовательности — обычная, однопоточная.
+    void EnableConcurrentReads();
+    bool IsConcurrent() const { return concurrent; }
 
 private:
     mutable DynamicArray<T>* items;
     int logicalLength;
-    mutable int materializedCount;
-    std::function<T(const LazySequence<T>&, int)> generator;
+    mutable long long materializedCount;
+    BatchGenerator generator;
     bool hasGenerator;
+    int blockSize;
+    mutable bool generating;
+    mutable int generatingBlock;  // режим Random: блок, который сейчас генерируется
+    BlockCache<T>* cache;   // только в режиме Random
+    int cacheBlocks;
+    bool indexed;           // генератор зависит только от индекса (Random, Indexed)
+    long long ringMask;     // неограниченный режим: items — кольцо из ringMask + 1 элементов
+    int window;
+    mutable long long fillEnd;  // конец генерируемого блока (вне генерации = materializedCount)
+
+    // Режим EnableConcurrentReads: materializedCount и generating принадлежат
+    // потоку-производителю, читатели видят только watermark.
+    bool concurrent;
+    const T* prefixData;                        // начало зарезервированного префикса
+    mutable std::atomic<long long> watermark;
+    mutable std::atomic<unsigned> epoch;        // растёт при каждой публикации и смене производителя
+    mutable std::atomic_flag producing;
+    mutable std::atomic<std::thread::id> producer;
 
-    void ensureMaterialized(int upto) const;
+    static BatchGenerator adaptElementGenerator(Generator generator);
+    T getConcurrent(long long index) const;
+    template<typename Fill>
+    void produceConcurrently(long long upto, Fill fill) const;
+    void publish() const;
+    void materializeParallel(int upto, int threads) const;
+    void ensureMaterialized(long long upto) const;
+    void checkBounded(const char* operation) const;
+    void reservePrefix(int count) const;
+    const T* randomBlock(int block) const;
 };
 
 template<typename T>
@@ -49,7 +187,21 @@ LazySequence<T>::LazySequence()
       logicalLength(0),
       materializedCount(0),
       generator(),
-      hasGenerator(false)
+      hasGenerator(false),
+      blockSize(1),
+      generating(false),
+      generatingBlock(-1),
+      cache(nullptr),
+      cacheBlocks(0),
+      indexed(false),
+      ringMask(0),
+      window(0),
+      fillEnd(0),
+      concurrent(false),
+      prefixData(nullptr),
+      watermark(0),
+      epoch(0),
+      producer()
 {
 }
 
@@ -59,7 +211,21 @@ LazySequence<T>::LazySequence(T* data, int count)
       logicalLength(count),
       materializedCount(count),
       generator(),
-      hasGenerator(false)
+      hasGenerator(false),
+      blockSize(1),
+      generating(false),
+      generatingBlock(-1),
+      cache(nullptr),
+      cacheBlocks(0),
+      indexed(false),
+      ringMask(0),
+      window(0),
+      fillEnd(0),
+      concurrent(false),
+      prefixData(nullptr),
+      watermark(0),
+      epoch(0),
+      producer()
 {
     for (int i = 0; i < count; ++i) {
         items->Set(i, data[i]);
@@ -72,7 +238,21 @@ LazySequence<T>::LazySequence(const Sequence<T>& other)
       logicalLength(other.GetLength()),
       materializedCount(0),
       generator(),
-      hasGenerator(false)
+      hasGenerator(false),
+      blockSize(1),
+      generating(false),
+      generatingBlock(-1),
+      cache(nullptr),
+      cacheBlocks(0),
+      indexed(false),
+      ringMask(0),
+      window(0),
+      fillEnd(0),
+      concurrent(false),
+      prefixData(nullptr),
+      watermark(0),
+      epoch(0),
+      producer()
 {
     items = new DynamicArray<T>(logicalLength);
     for (int i = 0; i < logicalLength; ++i) {
@@ -81,55 +261,224 @@ LazySequence<T>::LazySequence(const Sequence<T>& other)
     materializedCount = logicalLength;
 }
 
+// Кэш режима Random не копируется: копия начинает с пустого кэша и при
+// необходимости сгенерирует блоки заново. Префикс и кольцо копируются целиком.
 template<typename T>
 LazySequence<T>::LazySequence(const LazySequence<T>& other)
-    : items(new DynamicArray<T>(other.logicalLength)),
+    : items(new DynamicArray<T>(*other.items)),
       logicalLength(other.logicalLength),
       materializedCount(other.materializedCount),
       generator(other.generator),
-      hasGenerator(other.hasGenerator)
+      hasGenerator(other.hasGenerator),
+      blockSize(other.blockSize),
+      generating(false),
+      generatingBlock(-1),
+      cache(other.cache ? new BlockCache<T>(other.blockSize, other.cacheBlocks) : nullptr),
+      cacheBlocks(other.cacheBlocks),
+      indexed(other.indexed),
+      ringMask(other.ringMask),
+      window(other.window),
+      fillEnd(other.materializedCount),
+      concurrent(false),
+      prefixData(nullptr),
+      watermark(other.materializedCount),
+      epoch(0),
+      producer()
 {
-    for (int i = 0; i < other.materializedCount; ++i) {
-        items->Set(i, other.items->Get(i));
-    }
 }
 
 template<typename T>
 LazySequence<T>& LazySequence<T>::operator=(const LazySequence<T>& other) {
     if (this == &other) return *this;
+    BlockCache<T>* newCache = other.cache ? new BlockCache<T>(other.blockSize, other.cacheBlocks) : nullptr;
+    DynamicArray<T>* newItems = new DynamicArray<T>(*other.items);
     delete items;
+    delete cache;
+    items = newItems;
+    cache = newCache;
+    cacheBlocks = other.cacheBlocks;
+    indexed = other.indexed;
     logicalLength = other.logicalLength;
     materializedCount = other.materializedCount;
     generator = other.generator;
     hasGenerator = other.hasGenerator;
-    items = new DynamicArray<T>(logicalLength);
-    for (int i = 0; i < other.materializedCount; ++i) {
-        items->Set(i, other.items->Get(i));
-    }
+    blockSize = other.blockSize;
+    ringMask = other.ringMask;
+    window = other.window;
+    fillEnd = materializedCount;
+    concurrent = false;
+    prefixData = nullptr;
+    watermark.store(materializedCount);
     return *this;
 }
 
 template<typename T>
-LazySequence<T>::LazySequence(std::function<T(const LazySequence<T>&, int)> gen, int length)
-    : items(new DynamicArray<T>(length)),
+LazySequence<T>::LazySequence(Generator gen, int length)
+    : LazySequence(adaptElementGenerator(std::move(gen)), length, 1)
+{
+}
+
+template<typename T>
+LazySequence<T>::LazySequence(BatchGenerator gen, int length, int blockSize)
+    : items(nullptr),
       logicalLength(length),
       materializedCount(0),
-      generator(gen),
-      hasGenerator(true)
+      generator(std::move(gen)),
+      hasGenerator(true),
+      blockSize(blockSize),
+      generating(false),
+      generatingBlock(-1),
+      cache(nullptr),
+      cacheBlocks(0),
+      indexed(false),
+      ringMask(0),
+      window(0),
+      fillEnd(0),
+      concurrent(false),
+      prefixData(nullptr),
+      watermark(0),
+      epoch(0),
+      producer()
 {
     if (length < 0) {
         throw std::invalid_argument("length must be non-negative");
     }
+    if (blockSize <= 0) {
+        throw std::invalid_argument("block size must be positive");
+    }
+    items = new DynamicArray<T>(0);
+}
+
+template<typename T>
+LazySequence<T>::LazySequence(Generator gen, int length, Access access, int blockSize, int cacheBlocks)
+    : LazySequence(adaptElementGenerator(std::move(gen)), length, access,
+                   access == Access::Sequential ? 1 : blockSize, cacheBlocks)
+{
+}
+
+template<typename T>
+LazySequence<T>::LazySequence(BatchGenerator gen, int length, Access access, int blockSize, int cacheBlocks)
+    : LazySequence(std::move(gen), length, blockSize)
+{
+    indexed = access != Access::Sequential;
+    if (access == Access::Random) {
+        if (cacheBlocks <= 0) {
+            throw std::invalid_argument("cache size must be positive");
+        }
+        this->cacheBlocks = cacheBlocks;
+        cache = new BlockCache<T>(blockSize, cacheBlocks);
+    }
+}
+
+template<typename T>
+LazySequence<T>::LazySequence(Generator gen, Unbounded unbounded)
+    : LazySequence(adaptElementGenerator(std::move(gen)), unbounded, 1)
+{
+}
+
+// Кольцо вмещает window элементов назад плюс блок генерации (не меньше
+// kMinRingChunk, чтобы поэлементный генератор не упирался в край кольца).
+template<typename T>
+LazySequence<T>::LazySequence(BatchGenerator gen, Unbounded unbounded, int blockSize)
+    : LazySequence(std::move(gen), std::numeric_limits<int>::max(), blockSize)
+{
+    if (unbounded.window < 0) {
+        throw std::invalid_argument("window must be non-negative");
+    }
+    long long need = static_cast<long long>(unbounded.window) + (blockSize < kMinRingChunk ? kMinRingChunk : blockSize);
+    if (need > (1LL << 30)) {
+        throw std::invalid_argument("window is too large");
+    }
+    long long capacity = 1;
+    while (capacity < need) capacity *= 2;
+    window = unbounded.window;
+    ringMask = capacity - 1;
+    items->Resize(static_cast<int>(capacity));
+}
+
+// Поэлементный генератор обращается к предыдущим элементам через Get, поэтому
+// адаптер сдвигает materializedCount после каждого значения, а не после блока.
+// Генератору по индексу это не нужно (и недопустимо при параллельном заполнении).
+template<typename T>
+typename LazySequence<T>::BatchGenerator LazySequence<T>::adaptElementGenerator(Generator gen) {
+    return [gen = std::move(gen)](const LazySequence<T>& seq, long long start, T* out, int count) {
+        for (int k = 0; k < count; ++k) {
+            out[k] = gen(seq, start + k);
+            if (!seq.indexed) seq.materializedCount = start + k + 1;
+        }
+    };
 }
 
 template<typename T>
 LazySequence<T>::~LazySequence() {
     delete items;
+    delete cache;
 }
 
+// Префикс растёт вдвое, чтобы поблочная материализация не копировала его
+// на каждом блоке.
 template<typename T>
-void LazySequence<T>::ensureMaterialized(int upto) const {
-    if (upto < 0 || upto > logicalLength) {
+void LazySequence<T>::reservePrefix(int count) const {
+    if (count > items->GetCapacity()) {
+        int capacity = items->GetCapacity() * 2;
+        if (capacity < count) capacity = count;
+        if (capacity > logicalLength) capacity = logicalLength;
+        items->Reserve(capacity);
+    }
+    items->Resize(count);
+}
+
+template<typename T>
+void LazySequence<T>::checkBounded(const char* operation) const {
+    if (IsUnbounded()) {
+        throw std::logic_error(std::string(operation) + " is not supported by an unbounded sequence");
+    }
+}
+
+template<typename T>
+long long LazySequence<T>::GetOldestRetained() const {
+    if (!IsUnbounded()) return 0;
+    long long oldest = fillEnd - (ringMask + 1);
+    return oldest < 0 ? 0 : oldest;
+}
+
+template<typename T>
+const T* LazySequence<T>::randomBlock(int block) const {
+    // Генерируемый блок уже вставлен в кэш, но ещё не заполнен: Find нашёл
+    // бы его и вернул незаписанные элементы.
+    if (generating && block == generatingBlock) {
+        throw std::logic_error("generator in random access mode must not read the block being generated");
+    }
+    if (T* cached = cache->Find(block)) {
+        return cached;
+    }
+    if (generating) {
+        throw std::logic_error("generator in random access mode must not read uncached elements");
+    }
+    int start = block * blockSize;
+    int count = logicalLength - start < blockSize ? logicalLength - start : blockSize;
+    T* out = cache->Insert(block);
+    generating = true;
+    generatingBlock = block;
+    try {
+        generator(*this, start, out, count);
+    } catch (...) {
+        generating = false;
+        generatingBlock = -1;
+        cache->Erase(block);
+        throw;
+    }
+    generating = false;
+    generatingBlock = -1;
+    return out;
+}
+
+// В неограниченном режиме блок не должен ни перескакивать край кольца (out —
+// непрерывный массив), ни затирать последние window элементов перед start,
+// поэтому генерация идёт несколькими вызовами.
+template<typename T>
+void LazySequence<T>::ensureMaterialized(long long upto) const {
+    if (upto < 0 || (!IsUnbounded() && upto > logicalLength)) {
         throw std::out_of_range("index out of range");
     }
     if (!hasGenerator) {
@@ -138,11 +487,207 @@ void LazySequence<T>::ensureMaterialized(int upto) const {
         }
         return;
     }
-    for (int i = materializedCount; i < upto; ++i) {
-        T value = generator(*this, i);
-        items->Set(i, value);
-        materializedCount++;
+    if (upto <= materializedCount) {
+        return;
+    }
+    if (generating) {
+        throw std::logic_error("generator requested an element that is not generated yet");
+    }
+
+    while (materializedCount < upto) {
+        long long start = materializedCount;
+        long long count = upto - start;
+        if (blockSize > 1) {
+            count = (count + blockSize - 1) / blockSize * blockSize;
+        }
+
+        T* out;
+        if (IsUnbounded()) {
+            long long capacity = ringMask + 1;
+            long long offset = start & ringMask;
+            if (count > capacity - window) count = capacity - window;
+            if (count > capacity - offset) count = capacity - offset;
+            out = &items->UncheckedGet(static_cast<int>(offset));
+        } else {
+            if (count > logicalLength - start) count = logicalLength - start;
+            reservePrefix(static_cast<int>(start + count));
+            out = &items->UncheckedGet(static_cast<int>(start));
+        }
+
+        generating = true;
+        fillEnd = start + count;
+        try {
+            generator(*this, start, out, static_cast<int>(count));
+        } catch (...) {
+            generating = false;
+            fillEnd = materializedCount;
+            throw;
+        }
+        generating = false;
+        if (materializedCount < start + count) {
+            materializedCount = start + count;
+        }
+        fillEnd = materializedCount;
+        if (concurrent) {
+            publish();
+        }
+    }
+}
+
+template<typename T>
+void LazySequence<T>::MaterializeParallel(int upto, int threads) const {
+    if (cache || IsUnbounded()) {
+        throw std::logic_error("parallel materialization needs a bounded prefix sequence");
+    }
+    if (upto < 0 || upto > logicalLength) {
+        throw std::out_of_range("index out of range");
+    }
+    if (concurrent) {
+        produceConcurrently(upto, [&]() { materializeParallel(upto, threads); });
+    } else {
+        materializeParallel(upto, threads);
+    }
+}
+
+template<typename T>
+void LazySequence<T>::materializeParallel(int upto, int threads) const {
+    if (!hasGenerator || upto <= materializedCount) {
+        return;
+    }
+    if (!indexed) {
+        ensureMaterialized(upto);
+        return;
     }
+    if (generating) {
+        throw std::logic_error("generator requested an element that is not generated yet");
+    }
+
+    const int start = materializedCount;
+    const int chunk = std::max(blockSize, kParallelChunk);
+    const int chunks = static_cast<int>((static_cast<long long>(upto - start) + chunk - 1) / chunk);
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (threads <= 0) threads = 1;
+    }
+    threads = std::min(threads, chunks);
+
+    reservePrefix(upto);
+    T* out = &items->UncheckedGet(start);
+    std::atomic<int> nextChunk{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        while (!failed.load(std::memory_order_relaxed)) {
+            int c = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (c >= chunks) return;
+            int first = start + c * chunk;
+            int count = std::min(chunk, upto - first);
+            try {
+                generator(*this, first, out + (first - start), count);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    generating = true;
+    try {
+        for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    } catch (const std::system_error&) {
+        // потоков меньше, чем просили: куски разберут уже запущенные
+    }
+    worker();
+    for (std::thread& t : pool) t.join();
+    generating = false;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    materializedCount = upto;
+    fillEnd = upto;
+    if (concurrent) {
+        publish();
+    }
+}
+
+template<typename T>
+void LazySequence<T>::EnableConcurrentReads() {
+    if (cache || IsUnbounded()) {
+        throw std::logic_error("concurrent reads need a bounded prefix sequence");
+    }
+    if (concurrent) {
+        return;
+    }
+    items->Reserve(logicalLength);
+    prefixData = items->begin();
+    concurrent = true;
+    watermark.store(materializedCount, std::memory_order_release);
+}
+
+template<typename T>
+void LazySequence<T>::publish() const {
+    watermark.store(materializedCount, std::memory_order_release);
+    epoch.fetch_add(1, std::memory_order_release);
+    epoch.notify_all();
+}
+
+// Выполнить fill (достроить префикс хотя бы до upto) в роли единственного
+// производителя. Если роль занята — ждать публикаций; после ухода
+// производителя (в том числе по исключению) попробовать снова.
+template<typename T>
+template<typename Fill>
+void LazySequence<T>::produceConcurrently(long long upto, Fill fill) const {
+    for (;;) {
+        if (upto <= watermark.load(std::memory_order_acquire)) {
+            return;
+        }
+        unsigned seen = epoch.load(std::memory_order_acquire);
+        if (!producing.test_and_set(std::memory_order_acquire)) {
+            producer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+            auto release = [this]() {
+                producer.store(std::thread::id(), std::memory_order_relaxed);
+                producing.clear(std::memory_order_release);
+                epoch.fetch_add(1, std::memory_order_release);
+                epoch.notify_all();
+            };
+            try {
+                fill();
+            } catch (...) {
+                release();
+                throw;
+            }
+            release();
+            return;
+        }
+        // публикация могла случиться между проверкой отметки и чтением epoch
+        if (upto <= watermark.load(std::memory_order_acquire)) {
+            return;
+        }
+        epoch.wait(seen, std::memory_order_acquire);
+    }
+}
+
+template<typename T>
+T LazySequence<T>::getConcurrent(long long index) const {
+    if (index < watermark.load(std::memory_order_acquire)) {
+        return prefixData[index];
+    }
+    if (producer.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+        // генератор в потоке-производителе читает ещё не опубликованный префикс
+        if (index >= materializedCount) {
+            ensureMaterialized(index + 1);
+        }
+        return prefixData[index];
+    }
+    produceConcurrently(index + 1, [&]() { ensureMaterialized(index + 1); });
+    return prefixData[index];
 }
 
 template<typename T>
@@ -150,10 +695,41 @@ T LazySequence<T>::Get(int index) const {
     if (index < 0 || index >= logicalLength) {
         throw std::out_of_range("index out of range");
     }
+    if (concurrent) {
+        return getConcurrent(index);
+    }
+    // частый случай — уже материализованный элемент префикса
+    if (index < materializedCount && !cache && !IsUnbounded()) {
+        return items->UncheckedGet(index);
+    }
+    if (cache) {
+        int block = index / blockSize;
+        return randomBlock(block)[index - block * blockSize];
+    }
+    return GetAt(index);
+}
+
+template<typename T>
+T LazySequence<T>::GetAt(long long index) const {
+    if (index < 0 || (!IsUnbounded() && index >= logicalLength)) {
+        throw std::out_of_range("index out of range");
+    }
+    if (cache) {
+        return Get(static_cast<int>(index));
+    }
+    if (concurrent) {
+        return getConcurrent(index);
+    }
     if (index >= materializedCount) {
         ensureMaterialized(index + 1);
     }
-    return items->Get(index);
+    if (IsUnbounded()) {
+        if (index < GetOldestRetained()) {
+            throw std::out_of_range("element is outside the retention window");
+        }
+        return items->UncheckedGet(static_cast<int>(index & ringMask));
+    }
+    return items->Get(static_cast<int>(index));
 }
 
 template<typename T>
@@ -171,6 +747,7 @@ T LazySequence<T>::GetFirst() const {
 
 template<typename T>
 T LazySequence<T>::GetLast() const {
+    checkBounded("GetLast");
     if (logicalLength == 0) {
         throw std::out_of_range("sequence is empty");
     }
@@ -179,6 +756,7 @@ T LazySequence<T>::GetLast() const {
 
 template<typename T>
 Sequence<T>* LazySequence<T>::Append(T item) {
+    checkBounded("Append");
     int newLen = logicalLength + 1;
     T* buffer = new T[newLen];
     for (int i = 0; i < logicalLength; ++i) {
@@ -192,6 +770,7 @@ Sequence<T>* LazySequence<T>::Append(T item) {
 
 template<typename T>
 Sequence<T>* LazySequence<T>::Prepend(T item) {
+    checkBounded("Prepend");
     int newLen = logicalLength + 1;
     T* buffer = new T[newLen];
     buffer[0] = item;
@@ -205,6 +784,7 @@ Sequence<T>* LazySequence<T>::Prepend(T item) {
 
 template<typename T>
 Sequence<T>* LazySequence<T>::InsertAt(int index, T item) {
+    checkBounded("InsertAt");
     if (index < 0 || index > logicalLength) {
         throw std::out_of_range("index out of range");
     }
@@ -222,35 +802,20 @@ Sequence<T>* LazySequence<T>::InsertAt(int index, T item) {
     return result;
 }
 
+// Окно и конкатенация — представления (см. SliceSequence/ConcatSequence):
+// элементы генерируются только при обращении к ним, а не при построении.
 template<typename T>
 Sequence<T>* LazySequence<T>::GetSubsequence(int startIndex, int endIndex) const {
     if (startIndex < 0 || endIndex < startIndex || endIndex >= logicalLength) {
         throw std::out_of_range("index out of range");
     }
-    int newLen = endIndex - startIndex + 1;
-    T* buffer = new T[newLen];
-    for (int i = 0; i < newLen; ++i) {
-        buffer[i] = Get(startIndex + i);
-    }
-    auto* result = new LazySequence<T>(buffer, newLen);
-    delete[] buffer;
-    return result;
+    return new SliceSequence<T>(this, startIndex, endIndex);
 }
 
 template<typename T>
 Sequence<T>* LazySequence<T>::Concat(const Sequence<T>& other) const {
-    int otherLen = other.GetLength();
-    int newLen = logicalLength + otherLen;
-    T* buffer = new T[newLen];
-    for (int i = 0; i < logicalLength; ++i) {
-        buffer[i] = Get(i);
-    }
-    for (int i = 0; i < otherLen; ++i) {
-        buffer[logicalLength + i] = other.Get(i);
-    }
-    auto* result = new LazySequence<T>(buffer, newLen);
-    delete[] buffer;
-    return result;
+    checkBounded("Concat");
+    return ConcatSequence<T>::Make(this, &other);
 }
 
 template<typename T>
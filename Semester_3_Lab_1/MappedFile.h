@@ -0,0 +1,115 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Файл целиком, отображённый в память только для чтения: диапазон байт
+// [Data(), Data() + GetSize()). Страницы подгружаются ОС по мере обращения,
+// поэтому файл в несколько ГБ не копируется ни в буфер потока, ни в кучу.
+// Пустой файл даёт пустой диапазон (Data() == nullptr).
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& fileName);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* Data() const { return data; }
+    std::size_t GetSize() const { return size; }
+
+private:
+    const char* data;
+    std::size_t size;
+#if defined(_WIN32)
+    HANDLE mapping;
+#endif
+};
+
+#if defined(_WIN32)
+
+inline MappedFile::MappedFile(const std::string& fileName)
+    : data(nullptr),
+      size(0),
+      mapping(nullptr)
+{
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("cannot open file");
+    }
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length)) {
+        CloseHandle(file);
+        throw std::runtime_error("cannot read file size");
+    }
+    size = static_cast<std::size_t>(length.QuadPart);
+    if (size > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+    CloseHandle(file);
+    if (size > 0 && !data) {
+        if (mapping) CloseHandle(mapping);
+        throw std::runtime_error("cannot map file");
+    }
+}
+
+inline MappedFile::~MappedFile() {
+    if (data) UnmapViewOfFile(data);
+    if (mapping) CloseHandle(mapping);
+}
+
+#else
+
+inline MappedFile::MappedFile(const std::string& fileName)
+    : data(nullptr),
+      size(0)
+{
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open file");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("cannot read file size");
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    if (size > 0) {
+        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("cannot map file");
+        }
+        // чтение идёт подряд: ядро может подгружать страницы с опережением
+        ::madvise(mapped, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapped);
+    }
+    // отображение держится и после закрытия дескриптора
+    ::close(fd);
+}
+
+inline MappedFile::~MappedFile() {
+    if (data) ::munmap(const_cast<char*>(data), size);
+}
+
+#endif
+
+#endif
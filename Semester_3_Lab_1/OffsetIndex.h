@@ -0,0 +1,142 @@
+#ifndef OFFSET_INDEX_H
+#define OFFSET_INDEX_H
+
+#include "dynamic_array.h"
+#include "BinaryStreams.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+// Разреженный индекс текстового потока: байтовое смещение каждой stride-й
+// записи (0, stride, 2*stride, ...). С ним ReadOnlyStream переходит к записи
+// index, читая с ближайшей контрольной точки не больше stride - 1 записей.
+//
+// Индекс заполняет сам поток при первом проходе (ReadOnlyStream::AttachIndex);
+// после того как поток дочитан до конца, индекс полный: известны число
+// записей и размер входа. Полный индекс можно сохранить рядом с данными
+// (Save) и загрузить при следующем открытии вместо нового прохода.
+class SparseOffsetIndex {
+public:
+    explicit SparseOffsetIndex(int stride);
+    // Загрузить сохранённый через Save.
+    explicit SparseOffsetIndex(const std::string& fileName);
+
+    int GetStride() const { return stride; }
+    int GetCheckpointCount() const { return offsets.GetSize(); }
+    bool IsComplete() const { return complete; }
+    // Известны только для полного индекса.
+    std::size_t GetRecordCount() const { return recordCount; }
+    std::size_t GetSourceSize() const { return sourceSize; }
+
+    // Смещение записи checkpoint * stride.
+    std::size_t GetOffset(int checkpoint) const { return static_cast<std::size_t>(offsets[checkpoint]); }
+
+    // Для потока, строящего индекс: смещение следующей контрольной точки
+    // и конец входа.
+    void AddCheckpoint(std::size_t offset);
+    void Complete(std::size_t records, std::size_t bytes);
+
+    void Save(const std::string& fileName) const;
+
+private:
+    int stride;
+    bool complete;
+    std::size_t recordCount;
+    std::size_t sourceSize;
+    DynamicArray<std::uint64_t> offsets;
+};
+
+//   "PIDX", u32 stride, u64 число записей, u64 размер входа, u64 число точек,
+//   затем смещения; всё little-endian, как в BinaryStreams.h.
+namespace offset_index_format {
+    constexpr char kMagic[4] = {'P', 'I', 'D', 'X'};
+    constexpr std::size_t kHeaderSize = 32;
+}
+
+inline SparseOffsetIndex::SparseOffsetIndex(int stride)
+    : stride(stride),
+      complete(false),
+      recordCount(0),
+      sourceSize(0),
+      offsets(0)
+{
+    if (stride <= 0) {
+        throw std::invalid_argument("stride must be positive");
+    }
+    offsets.PushBack(0);
+}
+
+inline SparseOffsetIndex::SparseOffsetIndex(const std::string& fileName)
+    : stride(0),
+      complete(true),
+      recordCount(0),
+      sourceSize(0),
+      offsets(0)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("cannot open file");
+    }
+    char header[offset_index_format::kHeaderSize];
+    in.read(header, sizeof(header));
+    if (in.gcount() != static_cast<std::streamsize>(sizeof(header)) ||
+        std::memcmp(header, offset_index_format::kMagic, 4) != 0) {
+        throw std::runtime_error("not an offset index file");
+    }
+    std::uint32_t storedStride = binary_format::Load<std::uint32_t>(header + 4);
+    std::uint64_t checkpoints = binary_format::Load<std::uint64_t>(header + 24);
+    if (storedStride == 0 || storedStride > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
+        checkpoints == 0 || checkpoints > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("offset index file is corrupted");
+    }
+    stride = static_cast<int>(storedStride);
+    recordCount = static_cast<std::size_t>(binary_format::Load<std::uint64_t>(header + 8));
+    sourceSize = static_cast<std::size_t>(binary_format::Load<std::uint64_t>(header + 16));
+    offsets.Resize(static_cast<int>(checkpoints));
+    in.read(reinterpret_cast<char*>(offsets.begin()), static_cast<std::streamsize>(checkpoints * sizeof(std::uint64_t)));
+    if (in.gcount() != static_cast<std::streamsize>(checkpoints * sizeof(std::uint64_t))) {
+        throw std::runtime_error("offset index file is truncated");
+    }
+    for (std::uint64_t& offset : offsets) {
+        offset = binary_format::ToLittleEndian(offset);
+    }
+}
+
+inline void SparseOffsetIndex::AddCheckpoint(std::size_t offset) {
+    offsets.PushBack(static_cast<std::uint64_t>(offset));
+}
+
+inline void SparseOffsetIndex::Complete(std::size_t records, std::size_t bytes) {
+    complete = true;
+    recordCount = records;
+    sourceSize = bytes;
+}
+
+inline void SparseOffsetIndex::Save(const std::string& fileName) const {
+    if (!complete) {
+        throw std::logic_error("offset index is not complete yet");
+    }
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("cannot open file");
+    }
+    char header[offset_index_format::kHeaderSize] = {};
+    std::memcpy(header, offset_index_format::kMagic, 4);
+    binary_format::Store<std::uint32_t>(header + 4, static_cast<std::uint32_t>(stride));
+    binary_format::Store<std::uint64_t>(header + 8, recordCount);
+    binary_format::Store<std::uint64_t>(header + 16, sourceSize);
+    binary_format::Store<std::uint64_t>(header + 24, static_cast<std::uint64_t>(offsets.GetSize()));
+    out.write(header, sizeof(header));
+    for (std::uint64_t offset : offsets) {
+        char bytes[8];
+        binary_format::Store(bytes, offset);
+        out.write(bytes, sizeof(bytes));
+    }
+    if (!out) {
+        throw std::runtime_error("cannot write offset index");
+    }
+}
+
+#endif
@@ -2,9 +2,11 @@
 #define ONLINE_STATISTICS_H
 
 #include "dynamic_array.h"
+#include <cstddef>
 #include <stdexcept>
 #include <limits>
 #include <cmath>
+#include <utility>
 
 // ------------------------ Base interface ------------------------
 
@@ -13,6 +15,13 @@ class IStatistic {
 public:
     virtual ~IStatistic() {}
     virtual void Add(const T& value) = 0;
+
+    // Добавить count значений подряд (например, блок из ReadOnlyStream::ReadBlock).
+    virtual void AddRange(const T* values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            Add(values[i]);
+        }
+    }
 };
 
 // ------------------------ Mean ------------------------
@@ -27,6 +36,21 @@ public:
         ++count;
     }
 
+    void AddRange(const T* values, std::size_t n) override {
+        long double blockSum = 0.0L;
+        for (std::size_t i = 0; i < n; ++i) {
+            blockSum += static_cast<long double>(values[i]);
+        }
+        sum += blockSum;
+        count += static_cast<long long>(n);
+    }
+
+    // Объединить с накопленным по другой части данных.
+    void Merge(const MeanStatistic<T>& other) {
+        sum += other.sum;
+        count += other.count;
+    }
+
     long long GetCount() const {
         return count;
     }
@@ -59,6 +83,31 @@ public:
         m2 += delta * delta2;
     }
 
+    // Блок считается двумя проходами (среднее, затем сумма квадратов
+    // отклонений) и вливается в накопленное по формуле Чана — без деления
+    // на каждом элементе, как в Add.
+    void AddRange(const T* values, std::size_t n) override {
+        if (n == 0) return;
+        long double blockSum = 0.0L;
+        for (std::size_t i = 0; i < n; ++i) {
+            blockSum += static_cast<long double>(values[i]);
+        }
+        long double blockMean = blockSum / static_cast<long double>(n);
+        long double blockM2 = 0.0L;
+        for (std::size_t i = 0; i < n; ++i) {
+            long double d = static_cast<long double>(values[i]) - blockMean;
+            blockM2 += d * d;
+        }
+        merge(blockMean, blockM2, static_cast<long long>(n));
+    }
+
+    // Объединение частей по формуле Чана: результат тот же, что при
+    // последовательном Add всех значений, с точностью до округления.
+    void Merge(const VarianceStatistic<T>& other) {
+        if (other.count == 0) return;
+        merge(other.mean, other.m2, other.count);
+    }
+
     long long GetCount() const {
         return count;
     }
@@ -85,6 +134,15 @@ private:
     long double mean;
     long double m2;
     long long count;
+
+    void merge(long double otherMean, long double otherM2, long long otherCount) {
+        long long total = count + otherCount;
+        long double delta = otherMean - mean;
+        long double share = static_cast<long double>(otherCount) / static_cast<long double>(total);
+        mean += delta * share;
+        m2 += otherM2 + delta * delta * static_cast<long double>(count) * share;
+        count = total;
+    }
 };
 
 // ------------------------ Min / Max ------------------------
@@ -108,6 +166,25 @@ public:
         }
     }
 
+    void AddRange(const T* values, std::size_t n) override {
+        if (n == 0) return;
+        T lo = hasValue ? minValue : values[0];
+        T hi = hasValue ? maxValue : values[0];
+        for (std::size_t i = 0; i < n; ++i) {
+            if (values[i] < lo) lo = values[i];
+            if (values[i] > hi) hi = values[i];
+        }
+        minValue = lo;
+        maxValue = hi;
+        hasValue = true;
+    }
+
+    void Merge(const MinMaxStatistic<T>& other) {
+        if (!other.hasValue) return;
+        Add(other.minValue);
+        Add(other.maxValue);
+    }
+
     bool HasValue() const {
         return hasValue;
     }
@@ -151,11 +228,16 @@ public:
         return count;
     }
 
-    T Top() const {
+    // Элементы в порядке хранения (не отсортированы).
+    const T& At(int index) const {
+        return data[index];
+    }
+
+    const T& Top() const {
         if (count == 0) {
             throw std::runtime_error("heap is empty");
         }
-        return data.Get(0);
+        return data[0];
     }
 
     void Push(const T& value) {
@@ -163,7 +245,7 @@ public:
             int newCap = data.GetSize() == 0 ? 1 : data.GetSize() * 2;
             data.Resize(newCap);
         }
-        data.Set(count, value);
+        data[count] = value;
         siftUp(count);
         ++count;
     }
@@ -174,8 +256,7 @@ public:
         }
         --count;
         if (count > 0) {
-            T last = data.Get(count);
-            data.Set(0, last);
+            data[0] = std::move(data[count]);
             siftDown(0);
         }
     }
@@ -192,47 +273,34 @@ private:
         }
     }
 
+    // Индексы в siftUp/siftDown всегда < count <= data.GetSize(),
+    // поэтому работаем через непроверяемый operator[] по ссылке.
     void siftUp(int idx) {
+        T cur = std::move(data[idx]);
         while (idx > 0) {
             int parent = (idx - 1) / 2;
-            T cur = data.Get(idx);
-            T par = data.Get(parent);
-            if (!better(cur, par)) break;
-            // swap data[idx], data[parent]
-            data.Set(idx, par);
-            data.Set(parent, cur);
+            if (!better(cur, data[parent])) break;
+            data[idx] = std::move(data[parent]);
             idx = parent;
         }
+        data[idx] = std::move(cur);
     }
 
     void siftDown(int idx) {
+        T cur = std::move(data[idx]);
         while (true) {
             int left = idx * 2 + 1;
-            int right = idx * 2 + 2;
-            int best = idx;
-
-            if (left < count) {
-                T leftVal = data.Get(left);
-                T bestVal = data.Get(best);
-                if (better(leftVal, bestVal)) {
-                    best = left;
-                }
-            }
-            if (right < count) {
-                T rightVal = data.Get(right);
-                T bestVal = data.Get(best);
-                if (better(rightVal, bestVal)) {
-                    best = right;
-                }
+            if (left >= count) break;
+            int right = left + 1;
+            int best = left;
+            if (right < count && better(data[right], data[left])) {
+                best = right;
             }
-            if (best == idx) break;
-
-            T vIdx = data.Get(idx);
-            T vBest = data.Get(best);
-            data.Set(idx, vBest);
-            data.Set(best, vIdx);
+            if (!better(data[best], cur)) break;
+            data[idx] = std::move(data[best]);
             idx = best;
         }
+        data[idx] = std::move(cur);
     }
 };
 
@@ -267,6 +335,13 @@ public:
         return totalCount;
     }
 
+    // Медиана не складывается из частей, поэтому значения другой части
+    // добавляются по одному: O(m log n), зато результат точный.
+    void Merge(const MedianStatistic<T>& other) {
+        for (int i = 0; i < other.left.Size(); ++i) Add(other.left.At(i));
+        for (int i = 0; i < other.right.Size(); ++i) Add(other.right.At(i));
+    }
+
     double GetMedian() const {
         if (totalCount == 0) {
             throw std::runtime_error("no data for median");
@@ -320,6 +395,46 @@ public:
         ++count;
     }
 
+    // То же, что Add для каждого значения, но каждая статистика проходит
+    // блок своим циклом.
+    void AddRange(const T* values, std::size_t n) {
+        if (useMean) {
+            meanStat.AddRange(values, n);
+        }
+        if (useVariance) {
+            varStat.AddRange(values, n);
+        }
+        if (useMinMax) {
+            minmaxStat.AddRange(values, n);
+        }
+        if (useMedian) {
+            medianStat.AddRange(values, n);
+        }
+        count += static_cast<long long>(n);
+    }
+
+    // Добавить результаты по другой части данных (например, накопленные
+    // другим потоком). Набор включённых статистик должен совпадать.
+    void Merge(const OnlineStatistics<T>& other) {
+        if (useMean != other.useMean || useVariance != other.useVariance ||
+            useMinMax != other.useMinMax || useMedian != other.useMedian) {
+            throw std::invalid_argument("statistics sets differ");
+        }
+        if (useMean) {
+            meanStat.Merge(other.meanStat);
+        }
+        if (useVariance) {
+            varStat.Merge(other.varStat);
+        }
+        if (useMinMax) {
+            minmaxStat.Merge(other.minmaxStat);
+        }
+        if (useMedian) {
+            medianStat.Merge(other.medianStat);
+        }
+        count += other.count;
+    }
+
     long long GetCount() const {
         return count;
     }
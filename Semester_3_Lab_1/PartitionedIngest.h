@@ -0,0 +1,121 @@
+#ifndef PARTITIONED_INGEST_H
+#define PARTITIONED_INGEST_H
+
+#include "dynamic_array.h"
+#include "MappedFile.h"
+#include "OnlineStatistics.h"
+#include "Streams.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Параллельный разбор текстового файла чисел в OnlineStatistics.
+//
+// Отображённый файл режется на parts байтовых диапазонов, и каждая граница
+// сдвигается вперёд до ближайшего пробельного символа, так что число
+// целиком принадлежит диапазону, в котором начинается. Каждый поток разбирает
+// свои диапазоны ParseTextBlock прямо из страниц файла в собственный
+// OnlineStatistics, после чего части сливаются по порядку через Merge
+// (среднее и дисперсия — формула Чана, min/max — сравнением).
+
+constexpr std::size_t kMinPartitionBytes = 1 << 20;
+
+// Границы диапазонов: parts + 1 смещений, от 0 до size. Совпадающие
+// границы дают пустые диапазоны (если чисел меньше, чем частей).
+inline DynamicArray<std::size_t> SplitOnDelimiters(const char* data, std::size_t size, int parts) {
+    if (parts <= 0) {
+        throw std::invalid_argument("parts must be positive");
+    }
+    DynamicArray<std::size_t> bounds(parts + 1);
+    bounds[0] = 0;
+    for (int i = 1; i < parts; ++i) {
+        std::size_t b = static_cast<std::size_t>(static_cast<unsigned long long>(size) * i / parts);
+        if (b < bounds[i - 1]) b = bounds[i - 1];
+        while (b > 0 && b < size && !IsTextSpace(data[b - 1]) && !IsTextSpace(data[b])) ++b;
+        bounds[i] = b;
+    }
+    bounds[parts] = size;
+    return bounds;
+}
+
+// Добавить в stats все числа файла; threads == 0 — по числу ядер. Частей не
+// больше, чем по minPartitionBytes на часть: на маленьком файле потоки
+// дороже разбора. Как и при чтении через ReadOnlyStream, разбор
+// останавливается на первой не-числовой лексеме — всё после неё не
+// учитывается, в какой бы части оно ни было.
+template<typename T>
+void IngestPartitioned(const MappedFile& file, OnlineStatistics<T>& stats, int threads = 0,
+                       std::size_t minPartitionBytes = kMinPartitionBytes) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (threads <= 0) threads = 1;
+    }
+    const std::size_t size = file.GetSize();
+    std::size_t bySize = minPartitionBytes == 0 ? size : size / minPartitionBytes;
+    const int parts = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(threads, bySize)));
+    threads = std::min(threads, parts);
+
+    const char* data = file.Data();
+    DynamicArray<std::size_t> bounds = SplitOnDelimiters(data, size, parts);
+
+    std::vector<OnlineStatistics<T>> partial;
+    partial.reserve(parts);
+    for (int i = 0; i < parts; ++i) {
+        partial.emplace_back(stats.HasMean(), stats.HasVariance(), stats.HasMinMax(), stats.HasMedian());
+    }
+    DynamicArray<char> stopped(parts);    // часть закончилась на не-числовой лексеме
+    std::atomic<int> nextPart{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        const std::size_t blockSize = 4096;
+        DynamicArray<T> block(static_cast<int>(blockSize));
+        for (;;) {
+            int p = nextPart.fetch_add(1, std::memory_order_relaxed);
+            if (p >= parts) return;
+            stopped[p] = 0;
+            try {
+                const char* cursor = data + bounds[p];
+                const char* end = data + bounds[p + 1];
+                for (;;) {
+                    std::size_t produced = 0;
+                    bool ok = ParseTextBlock<T>(cursor, end, true, block.begin(), blockSize, produced);
+                    partial[p].AddRange(block.begin(), produced);
+                    if (!ok) {
+                        stopped[p] = 1;
+                        break;
+                    }
+                    if (produced < blockSize) break;
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    try {
+        for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    } catch (const std::system_error&) {
+        // потоков меньше, чем просили: части разберут уже запущенные
+    }
+    worker();
+    for (std::thread& t : pool) t.join();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    for (int i = 0; i < parts; ++i) {
+        stats.Merge(partial[i]);
+        if (stopped[i]) break;
+    }
+}
+
+#endif
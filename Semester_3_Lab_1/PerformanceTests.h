@@ -3,12 +3,33 @@
 
 #include <iostream>
 #include <chrono>
+#include <thread>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 
+#include "sequence.h"
+#include "Lists.h"
+#include "UnrolledList.h"
 #include "LazySequence.h"
 #include "OnlineStatistics.h"
 #include "Streams.h"
+#include "BinaryStreams.h"
+#include "AsyncStreams.h"
+#include "MappedFile.h"
+#include "AllocTracking.h"
+#include "ProcessMemory.h"
+
+// Выделения памяти за время scope: всего, на элемент и пик занятой памяти.
+// Печатается только в сборке с учётом выделений (ALLOC_TRACKING).
+inline void ReportAllocations(const AllocScope& scope, std::size_t n) {
+    if (!AllocTrackingEnabled()) return;
+    std::cout << "Allocations:         " << scope.Allocations()
+              << " (" << static_cast<double>(scope.Allocations()) / static_cast<double>(n) << " per element)"
+              << ", peak +" << scope.PeakBytes() / 1024 << " KB\n";
+}
 
 inline void PerformanceTestLazySequence(std::size_t n) {
     std::cout << "\n=== Performance test: LazySequence (n = " << n << ") ===\n";
@@ -28,6 +49,7 @@ inline void PerformanceTestLazySequence(std::size_t n) {
         return index;
     };
 
+    AllocScope allocs;
     LazySequence<int> seq(gen, static_cast<int>(n));
 
     auto start = std::chrono::steady_clock::now();
@@ -45,6 +67,51 @@ inline void PerformanceTestLazySequence(std::size_t n) {
     std::cout << "Generator calls:     " << generatorCalls << "\n";
     std::cout << "Sum of elements:     " << sum << "\n";
     std::cout << "Elapsed time:        " << ms << " ms\n";
+    ReportAllocations(allocs, n);
+
+    // то же через блочный генератор: один вызов на kDefaultBlockSize элементов
+    int batchCalls = 0;
+    auto batch = [&batchCalls](const LazySequence<int>&, int first, int* out, int count) {
+        ++batchCalls;
+        for (int k = 0; k < count; ++k) out[k] = first + k;
+    };
+    LazySequence<int> batched(batch, static_cast<int>(n));
+
+    start = std::chrono::steady_clock::now();
+    long long batchSum = 0;
+    for (int i = 0; i < length; ++i) {
+        batchSum += batched.Get(i);
+    }
+    end = std::chrono::steady_clock::now();
+    ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << "Batch generator:     " << batchCalls << " calls, sum " << batchSum
+              << (batchSum == sum ? "" : " (MISMATCH)") << ", " << ms << " ms\n";
+
+    // параллельная материализация генератора, зависящего только от индекса
+    LazySequence<int> indexed(batch, static_cast<int>(n), LazySequence<int>::Access::Indexed);
+    unsigned hw = std::thread::hardware_concurrency();
+    start = std::chrono::steady_clock::now();
+    indexed.MaterializeParallel(static_cast<int>(n));
+    end = std::chrono::steady_clock::now();
+    ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    std::cout << "Parallel fill:       " << (hw ? hw : 1) << " threads, " << ms << " ms\n";
+
+    // произвольный доступ по замкнутой формуле к последовательности длины INT_MAX
+    AllocScope randomAllocs;
+    LazySequence<int> random(batch, std::numeric_limits<int>::max(), LazySequence<int>::Access::Random);
+    unsigned x = 12345;
+    long long randomSum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < length; ++i) {
+        x = x * 1664525u + 1013904223u;
+        randomSum += random.Get(static_cast<int>(x % static_cast<unsigned>(std::numeric_limits<int>::max())));
+    }
+    end = std::chrono::steady_clock::now();
+    ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    std::cout << "Random access:       " << length << " Get over length " << random.GetLength()
+              << ", " << random.GetCachedBlocks() << " blocks cached, " << ms << " ms\n";
+    ReportAllocations(randomAllocs, n);
 }
 
 inline void PerformanceTestOnlineStatistics(std::size_t n) {
@@ -55,6 +122,7 @@ inline void PerformanceTestOnlineStatistics(std::size_t n) {
         return;
     }
 
+    AllocScope allocs;
     OnlineStatistics<double> stats(true, true, true, true);
 
     auto start = std::chrono::steady_clock::now();
@@ -68,6 +136,7 @@ inline void PerformanceTestOnlineStatistics(std::size_t n) {
 
     std::cout << "Total elements processed: " << stats.GetCount() << "\n";
     std::cout << "Elapsed time:             " << ms << " ms\n";
+    ReportAllocations(allocs, n);
 
     // Simple correctness check for moderate n:
     try {
@@ -111,6 +180,7 @@ inline void PerformanceTestStream(std::size_t n) {
         return static_cast<bool>(in >> value);
     };
 
+    AllocScope allocs;
     ReadOnlyStream<long long> stream(ss, deserializer);
 
     auto start = std::chrono::steady_clock::now();
@@ -129,6 +199,241 @@ inline void PerformanceTestStream(std::size_t n) {
     std::cout << "Total elements read: " << count << "\n";
     std::cout << "Sum of elements:     " << sum << "\n";
     std::cout << "Elapsed time:        " << ms << " ms\n";
+    ReportAllocations(allocs, count);
+
+    // тот же вход блоками: буфер по 64 КБ и разбор from_chars вместо >>
+    std::stringstream again(ss.str());
+    AllocScope blockAllocs;
+    ReadOnlyStream<long long> blockStream(again, ReadOnlyStream<long long>::BlockDeserializer(ParseTextBlock<long long>));
+    const std::size_t blockSize = 4096;
+    long long block[blockSize];
+
+    start = std::chrono::steady_clock::now();
+
+    long long blockSum = 0;
+    std::size_t blockCount = 0;
+    while (blockCount < n) {
+        std::size_t got = blockStream.ReadBlock(block, std::min(blockSize, n - blockCount));
+        for (std::size_t i = 0; i < got; ++i) blockSum += block[i];
+        blockCount += got;
+        if (got == 0) break;
+    }
+
+    end = std::chrono::steady_clock::now();
+    auto blockMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << "ReadBlock elements:  " << blockCount << (blockSum == sum ? "" : " (sum mismatch!)") << "\n";
+    std::cout << "ReadBlock time:      " << blockMs << " ms\n";
+    ReportAllocations(blockAllocs, blockCount);
+
+    // и из файла, отображённого в память: без istream и без копии в буфер
+    const char* tempName = "stream_perf_test.tmp";
+    {
+        std::ofstream tmp(tempName, std::ios::binary);
+        tmp << again.str();
+    }
+    try {
+        MappedFile file(tempName);
+        AllocScope mappedAllocs;
+        ReadOnlyStream<long long> mappedStream(file);
+
+        start = std::chrono::steady_clock::now();
+
+        long long mappedSum = 0;
+        std::size_t mappedCount = 0;
+        std::size_t got;
+        while ((got = mappedStream.ReadBlock(block, blockSize)) > 0) {
+            for (std::size_t i = 0; i < got; ++i) mappedSum += block[i];
+            mappedCount += got;
+        }
+
+        end = std::chrono::steady_clock::now();
+        auto mappedMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+        std::cout << "Mapped elements:     " << mappedCount << (mappedSum == sum ? "" : " (sum mismatch!)") << "\n";
+        std::cout << "Mapped time:         " << mappedMs << " ms\n";
+        ReportAllocations(mappedAllocs, mappedCount);
+    } catch (const std::exception& ex) {
+        std::cout << "Mapped file unavailable: " << ex.what() << "\n";
+    }
+    std::remove(tempName);
+
+    // двоичный формат: сохранить и загрузить те же числа без разбора текста
+    std::stringstream binary;
+    start = std::chrono::steady_clock::now();
+    {
+        BinaryWriteOnlyStream<long long> writer(binary);
+        for (std::size_t i = 0; i < n; ++i) writer.Write(static_cast<long long>(i));
+    }
+    auto writeMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    AllocScope binaryAllocs;
+    start = std::chrono::steady_clock::now();
+    BinaryReadOnlyStream<long long> binaryStream(binary);
+    long long binarySum = 0;
+    std::size_t binaryCount = 0;
+    std::size_t got;
+    while ((got = binaryStream.ReadBlock(block, blockSize)) > 0) {
+        for (std::size_t i = 0; i < got; ++i) binarySum += block[i];
+        binaryCount += got;
+    }
+    end = std::chrono::steady_clock::now();
+    auto binaryMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << "Binary elements:     " << binaryCount << (binarySum == sum ? "" : " (sum mismatch!)") << "\n";
+    std::cout << "Binary write / read: " << writeMs << " / " << binaryMs << " ms\n";
+    ReportAllocations(binaryAllocs, binaryCount);
+
+    // разбор текста в фоновом потоке, статистика — в этом
+    for (int async = 0; async <= 1; ++async) {
+        std::stringstream text(again.str());
+        ReadOnlyStream<double> source(text, ReadOnlyStream<double>::BlockDeserializer(ParseTextBlock<double>));
+        OnlineStatistics<double> stats(true, true, true, false);
+        start = std::chrono::steady_clock::now();
+        long long consumerStalls = 0, producerStalls = 0;
+        if (async) {
+            AsyncReadOnlyStream<double, ReadOnlyStream<double>> prefetch(source);
+            const double* data;
+            std::size_t count;
+            while (prefetch.NextBlock(data, count)) stats.AddRange(data, count);
+            consumerStalls = prefetch.GetConsumerStalls();
+            producerStalls = prefetch.GetProducerStalls();
+        } else {
+            double values[blockSize];
+            std::size_t count;
+            while ((count = source.ReadBlock(values, blockSize)) > 0) stats.AddRange(values, count);
+        }
+        end = std::chrono::steady_clock::now();
+        std::cout << (async ? "Prefetched + stats:  " : "ReadBlock + stats:   ")
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms";
+        if (async) {
+            std::cout << " (stalls: consumer " << consumerStalls << ", producer " << producerStalls << ")";
+        }
+        std::cout << (stats.GetCount() == static_cast<long long>(n) ? "" : " (count mismatch!)") << "\n";
+    }
+}
+
+// Append в MutableArraySequence: n = 10^3 .. maxN (x10).
+// При амортизированном O(1) время на один Append не должно расти с n.
+inline void PerformanceTestArraySequenceAppend(std::size_t maxN) {
+    std::cout << "\n=== Performance test: MutableArraySequence::Append (up to n = " << maxN << ") ===\n";
+
+    if (maxN > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        maxN = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    }
+
+    for (std::size_t n = 1000; n <= maxN; n *= 10) {
+        AllocScope allocs;
+        MutableArraySequence<int> seq;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < n; ++i) {
+            seq.Append(static_cast<int>(i));
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        std::cout << "n = " << n
+                  << "\ttotal: " << ns / 1000000 << " ms"
+                  << "\tper append: " << static_cast<double>(ns) / static_cast<double>(n) << " ns"
+                  << "\tlength: " << seq.GetLength();
+        if (AllocTrackingEnabled())
+            std::cout << "\tallocations: " << allocs.Allocations();
+        std::cout << "\n";
+    }
+}
+
+// k версий подряд: версия i+1 = версия i + один элемент, все версии живы.
+// copy — каждая версия хранит полную копию массива (прежний ImmutableArraySequence);
+// persistent — персистентный вектор с общими узлами.
+inline void MeasureVersionHistory(const char* name, int k, bool copy) {
+    DynamicArray<Sequence<int>*> versions(0);
+    versions.Reserve(k + 1);
+
+    long long rss0 = CurrentRssKB();
+    AllocScope allocs;
+    auto start = std::chrono::steady_clock::now();
+
+    if (copy) versions.PushBack(new MutableArraySequence<int>());
+    else versions.PushBack(new ImmutableArraySequence<int>());
+    for (int i = 0; i < k; ++i) {
+        Sequence<int>* last = versions[versions.GetSize() - 1];
+        if (copy) versions.PushBack(last->Clone()->Append(i));
+        else versions.PushBack(last->Append(i));
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    long long rss1 = CurrentRssKB();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << name << "\tk = " << k
+              << "\ttime: " << ms << " ms"
+              << "\tRSS: +" << (rss1 - rss0) << " KB"
+              << "\t(" << static_cast<double>(rss1 - rss0) * 1024.0 / k << " B/version)";
+    if (AllocTrackingEnabled())
+        std::cout << "\tallocs/version: " << static_cast<double>(allocs.Allocations()) / k
+                  << "\tpeak: +" << allocs.PeakBytes() / 1024 << " KB";
+    std::cout << "\n";
+
+    for (Sequence<int>* v : versions) delete v;
+}
+
+// Рост памяти истории версий ImmutableArraySequence: персистентное дерево против полных копий.
+// Полные копии стоят O(k^2) памяти, поэтому для них k ограничен 10^4.
+inline void PerformanceTestImmutableVersions(int maxK) {
+    std::cout << "\n=== Performance test: ImmutableArraySequence version history (up to k = " << maxK << ") ===\n";
+    for (int k = 1000; k <= maxK; k *= 10) {
+        MeasureVersionHistory("persistent", k, false);
+        if (k <= 10000) MeasureVersionHistory("full copy ", k, true);
+    }
+}
+
+// Сумма n элементов обходом по собственным итераторам контейнера; ns на элемент.
+template<typename Seq>
+inline double MeasureSequenceIteration(const Seq& seq, long long& sum) {
+    auto start = std::chrono::steady_clock::now();
+    sum = 0;
+    for (int value : seq) {
+        sum += value;
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(ns) / static_cast<double>(seq.GetLength());
+}
+
+// Пропускная способность обхода: массив vs список vs развёрнутый список.
+inline void PerformanceTestSequenceIteration(std::size_t n) {
+    std::cout << "\n=== Performance test: iteration ArraySequence / ListSequence / UnrolledListSequence (n = "
+              << n << ") ===\n";
+
+    if (n == 0) {
+        std::cout << "Nothing to test (n = 0).\n";
+        return;
+    }
+    if (n > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        n = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    }
+
+    int size = static_cast<int>(n);
+    int* data = new int[size];
+    for (int i = 0; i < size; ++i) data[i] = i;
+    MutableArraySequence<int> array(data, size);
+    MutableListSequence<int> list(data, size);
+    MutableUnrolledListSequence<int> unrolled(data, size);
+    delete[] data;
+
+    long long sumArray = 0, sumList = 0, sumUnrolled = 0;
+    double nsArray = MeasureSequenceIteration(array, sumArray);
+    double nsList = MeasureSequenceIteration(list, sumList);
+    double nsUnrolled = MeasureSequenceIteration(unrolled, sumUnrolled);
+
+    std::cout << "ArraySequence:         " << nsArray << " ns/elem (sum " << sumArray << ")\n";
+    std::cout << "ListSequence:          " << nsList << " ns/elem (x" << nsList / nsArray << ")\n";
+    std::cout << "UnrolledListSequence:  " << nsUnrolled << " ns/elem (x" << nsUnrolled / nsArray << ")\n";
+    if (sumList != sumArray || sumUnrolled != sumArray)
+        std::cout << "Sum mismatch!\n";
 }
 
 inline void RunPerformanceTests() {
@@ -143,6 +448,9 @@ inline void RunPerformanceTests() {
     PerformanceTestLazySequence(n);
     PerformanceTestOnlineStatistics(n);
     PerformanceTestStream(n);
+    PerformanceTestArraySequenceAppend(10000000);
+    PerformanceTestSequenceIteration(n);
+    PerformanceTestImmutableVersions(100000);
 
     std::cout << "\nAll performance tests finished.\n";
 }
@@ -2,25 +2,97 @@
 #define STREAMS_H
 
 #include "sequence.h"
+#include "MappedFile.h"
+#include "OffsetIndex.h"
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <charconv>
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <string>
 #include <stdexcept>
+#include <system_error>
+
+// ------------------------ Текстовый формат блоками ------------------------
+
+// Разбор чисел, разделённых пробельными символами, из буфера [cursor, end):
+// до max значений в out, produced — сколько записано, cursor сдвигается за
+// последнее разобранное. Пока atEnd == false, лексема, упирающаяся в end,
+// может быть обрезана — она остаётся на следующий вызов. false — встретилась
+// не-числовая лексема (как отказ operator>>), cursor стоит на ней.
+// Пробельные символы "C"-локали; std::isspace на каждый байт заметно дороже.
+inline bool IsTextSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+template<typename T>
+bool ParseTextBlock(const char*& cursor, const char* end, bool atEnd, T* out, std::size_t max, std::size_t& produced) {
+    produced = 0;
+    const char* p = cursor;
+    while (produced < max) {
+        while (p < end && IsTextSpace(*p)) ++p;
+        cursor = p;
+        if (p == end) break;
+        const char* tokenEnd = p;
+        while (tokenEnd < end && !IsTextSpace(*tokenEnd)) ++tokenEnd;
+        if (tokenEnd == end && !atEnd) break;
+        if (*p == '+') ++p;    // from_chars, в отличие от >>, не принимает '+'
+        auto [stop, error] = std::from_chars(p, tokenEnd, out[produced]);
+        if (error != std::errc() || stop != tokenEnd) {
+            return false;
+        }
+        p = tokenEnd;
+        cursor = p;
+        ++produced;
+    }
+    return true;
+}
+
+// Запись значений через пробел (как сериализатор "out << x << ' '").
+template<typename T>
+void FormatTextBlock(std::string& buffer, const T* values, std::size_t count) {
+    char digits[64];
+    for (std::size_t i = 0; i < count; ++i) {
+        auto [stop, error] = std::to_chars(digits, digits + sizeof(digits), values[i]);
+        if (error != std::errc()) {
+            throw std::runtime_error("cannot format value");
+        }
+        buffer.append(digits, stop);
+        buffer.push_back(' ');
+    }
+}
 
 template<typename T>
 class ReadOnlyStream {
 public:
     using Deserializer = std::function<bool(std::istream&, T&)>;
+    // Разбор сразу целого куска входа, контракт — как у ParseTextBlock.
+    using BlockDeserializer = std::function<bool(const char*& cursor, const char* end, bool atEnd,
+                                                 T* out, std::size_t max, std::size_t& produced)>;
+
+    // Начальный размер буфера для BlockDeserializer; растёт, если в него не
+    // помещается одна лексема.
+    static constexpr std::size_t kReadBufferSize = 1 << 16;
 
     // Stream from Sequence<T> (including LazySequence<T>)
     explicit ReadOnlyStream(Sequence<T>* seqSource)
         : type(SourceType::Sequence),
           seq(seqSource),
+          cursorVersion(0),
           in(nullptr),
           ownedStream(nullptr),
           deserializer(),
+          blockDeserializer(),
+          bufferSize(0),
+          bufferBegin(0),
+          bufferEnd(0),
+          inputDone(false),
+          mapped(nullptr),
+          streamOffset(0),
+          inputBase(0),
+          index(nullptr),
           position(0),
           endReached(false),
           opened(true) {}
@@ -29,31 +101,77 @@ public:
     ReadOnlyStream(std::istream& input, Deserializer d)
         : type(SourceType::IStream),
           seq(nullptr),
+          cursorVersion(0),
           in(&input),
           ownedStream(nullptr),
           deserializer(d),
+          blockDeserializer(),
+          bufferSize(0),
+          bufferBegin(0),
+          bufferEnd(0),
+          inputDone(false),
+          mapped(nullptr),
+          streamOffset(0),
+          inputBase(0),
+          index(nullptr),
+          position(0),
+          endReached(false),
+          opened(true) {}
+
+    // Чтение из std::istream большими кусками через буфер
+    ReadOnlyStream(std::istream& input, BlockDeserializer d)
+        : type(SourceType::IStream),
+          seq(nullptr),
+          cursorVersion(0),
+          in(&input),
+          ownedStream(nullptr),
+          deserializer(),
+          blockDeserializer(d),
+          bufferSize(0),
+          bufferBegin(0),
+          bufferEnd(0),
+          inputDone(false),
+          mapped(nullptr),
+          streamOffset(0),
+          inputBase(0),
+          index(nullptr),
           position(0),
           endReached(false),
           opened(true) {}
 
     // Stream from file
     ReadOnlyStream(const std::string& fileName, Deserializer d)
-        : type(SourceType::IStream),
+        : ReadOnlyStream(fileName) {
+        deserializer = d;
+    }
+
+    ReadOnlyStream(const std::string& fileName, BlockDeserializer d)
+        : ReadOnlyStream(fileName) {
+        blockDeserializer = d;
+    }
+
+    // Разбор прямо из отображённого в память файла, без копирования в буфер.
+    // MappedFile должен жить дольше потока. Позиционирование — по номеру
+    // элемента (Seek) или по байтовому смещению (SeekByte / GetByteOffset).
+    explicit ReadOnlyStream(const MappedFile& file, BlockDeserializer d = BlockDeserializer(ParseTextBlock<T>))
+        : type(SourceType::Mapped),
           seq(nullptr),
+          cursorVersion(0),
           in(nullptr),
-          ownedStream(new std::ifstream(fileName)),
-          deserializer(d),
+          ownedStream(nullptr),
+          deserializer(),
+          blockDeserializer(d),
+          bufferSize(file.GetSize()),
+          bufferBegin(0),
+          bufferEnd(file.GetSize()),
+          inputDone(true),
+          mapped(file.Data()),
+          streamOffset(0),
+          inputBase(0),
+          index(nullptr),
           position(0),
           endReached(false),
-          opened(false)
-    {
-        if (!ownedStream->is_open()) {
-            delete ownedStream;
-            ownedStream = nullptr;
-            throw std::runtime_error("cannot open file");
-        }
-        in = ownedStream;
-    }
+          opened(true) {}
 
     ~ReadOnlyStream() {
         Close();
@@ -85,7 +203,8 @@ public:
     }
 
     bool IsCanSeek() const {
-        return type == SourceType::Sequence && seq != nullptr;
+        return (type == SourceType::Sequence && seq != nullptr) || type == SourceType::Mapped
+            || (type == SourceType::IStream && index != nullptr);
     }
 
     bool IsCanGoBack() const {
@@ -100,6 +219,10 @@ public:
         if (!IsCanSeek()) {
             throw std::runtime_error("seek is not supported for this stream");
         }
+        if (type != SourceType::Sequence) {
+            seekText(index);
+            return;
+        }
         if (!seq) {
             throw std::runtime_error("no sequence source");
         }
@@ -107,6 +230,54 @@ public:
             index = static_cast<std::size_t>(seq->GetLength());
         }
         position = index;
+        cursor.reset(); // пересоздаётся на новой позиции при следующем чтении
+    }
+
+    // Подключить разреженный индекс смещений (до первого чтения; нужен
+    // BlockDeserializer). Неполный индекс поток достраивает сам, пока читает;
+    // полный сверяется с размером входа. С индексом Seek для файла или
+    // istream с seekg стоит O(stride): переход к контрольной точке и
+    // дочитывание. Индекс должен жить дольше потока; несколько потоков могут
+    // делить только полный индекс.
+    void AttachIndex(SparseOffsetIndex& offsets) {
+        if (type == SourceType::Sequence || !blockDeserializer) {
+            throw std::logic_error("offset index needs a text stream with a BlockDeserializer");
+        }
+        if (position != 0 || bufferBegin != 0 || streamOffset != 0 || (type == SourceType::IStream && bufferEnd != 0)) {
+            throw std::logic_error("offset index must be attached before the first read");
+        }
+        if (type == SourceType::IStream) {
+            std::streampos base = in->tellg();
+            if (base == std::streampos(-1)) {
+                throw std::runtime_error("input stream is not seekable");
+            }
+            inputBase = base;
+        }
+        if (offsets.IsComplete() && offsets.GetSourceSize() != sourceSize()) {
+            throw std::runtime_error("offset index does not match the source");
+        }
+        index = &offsets;
+    }
+
+    // Смещение в байтах от начала входа до следующего непрочитанного
+    // элемента (для потоков с BlockDeserializer).
+    std::size_t GetByteOffset() const {
+        if (type == SourceType::Sequence || !blockDeserializer) {
+            throw std::runtime_error("byte offsets are not available for this stream");
+        }
+        return streamOffset + bufferBegin;
+    }
+
+    // Перейти к байту offset отображённого файла. offset должен быть границей
+    // элемента (например, ранее полученный GetByteOffset), index — номер
+    // элемента, который там начинается: его дальше возвращает GetPosition.
+    void SeekByte(std::size_t offset, std::size_t index) {
+        if (type != SourceType::Mapped) {
+            throw std::runtime_error("byte seek is supported only for mapped files");
+        }
+        bufferBegin = offset < bufferEnd ? offset : bufferEnd;
+        position = index;
+        endReached = false;
     }
 
     T Read() {
@@ -119,13 +290,42 @@ public:
 
     bool TryRead(T& value) {
         if (!opened) return false;
+        if (blockDeserializer) {
+            return ReadBlock(&value, 1) == 1;
+        }
 
         if (type == SourceType::Sequence) {
             if (!seq) return false;
             if (position >= static_cast<std::size_t>(seq->GetLength())) {
                 return false;
             }
-            value = seq->Get(static_cast<int>(position));
+            // Источник может меняться между чтениями (Append у Mutable*
+            // последовательностей работает на месте). Непрерывное хранилище
+            // индексируется заново на каждом чтении. Представление
+            // (SliceSequence/ConcatSequence) не знает, переехало ли хранилище
+            // под ним, поэтому читается через Get.
+            std::span<const T> items;
+            if (seq->TryGetContiguous(items)) {
+                value = items[position];
+                ++position;
+                return true;
+            }
+            if (seq->ViewDepth() > 0) {
+                value = seq->Get(static_cast<int>(position));
+                ++position;
+                return true;
+            }
+            // Собственное несплошное хранилище (списки): курсор стоит на
+            // последнем прочитанном элементе и сдвигается перед чтением, так
+            // что Append между чтениями не требует нового прохода с головы —
+            // O(1) на элемент. Пересоздаётся, только если элементы сдвинулись.
+            if (!cursor || cursorVersion != seq->GetLayoutVersion()) {
+                cursor = seq->CreateCursor(static_cast<int>(position));
+                cursorVersion = seq->GetLayoutVersion();
+            } else {
+                cursor->Next();
+            }
+            value = cursor->Current();
             ++position;
             return true;
         } else {
@@ -142,20 +342,189 @@ public:
         }
     }
 
+    // Прочитать до max элементов подряд в out; меньше max — только в конце
+    // потока. С BlockDeserializer вход читается кусками по kReadBufferSize
+    // и разбирается целиком, без вызова функции на каждый элемент.
+    std::size_t ReadBlock(T* out, std::size_t max) {
+        if (!opened) return 0;
+        if (type != SourceType::Sequence && blockDeserializer) {
+            return readBuffered(out, max);
+        }
+        std::size_t count = 0;
+        while (count < max && TryRead(out[count])) {
+            ++count;
+        }
+        return count;
+    }
+
 private:
     enum class SourceType {
         Sequence,
-        IStream
+        IStream,
+        Mapped
     };
 
     SourceType type;
     Sequence<T>* seq;
+    std::unique_ptr<typename Sequence<T>::Cursor> cursor;
+    unsigned long long cursorVersion;     // seq->GetLayoutVersion() при создании cursor
     std::istream* in;
     std::ifstream* ownedStream;
     Deserializer deserializer;
+    BlockDeserializer blockDeserializer;
+    std::unique_ptr<char[]> buffer;
+    std::size_t bufferSize;
+    std::size_t bufferBegin;    // [bufferBegin, bufferEnd) — ещё не разобранный вход
+    std::size_t bufferEnd;
+    bool inputDone;             // istream исчерпан, в буфере — последний кусок
+    const char* mapped;         // Mapped: весь файл вместо buffer
+    std::size_t streamOffset;   // байт входа до начала buffer
+    std::streampos inputBase;   // позиция istream, от которой считаются смещения
+    SparseOffsetIndex* index;
     std::size_t position;
     bool endReached;
     bool opened;
+
+    // Открытие файла для конструкторов с именем файла; десериализатор
+    // задаёт вызывающий.
+    explicit ReadOnlyStream(const std::string& fileName)
+        : type(SourceType::IStream),
+          seq(nullptr),
+          cursorVersion(0),
+          in(nullptr),
+          ownedStream(new std::ifstream(fileName, std::ios::binary)),
+          deserializer(),
+          blockDeserializer(),
+          bufferSize(0),
+          bufferBegin(0),
+          bufferEnd(0),
+          inputDone(false),
+          mapped(nullptr),
+          streamOffset(0),
+          inputBase(0),
+          index(nullptr),
+          position(0),
+          endReached(false),
+          opened(false)
+    {
+        if (!ownedStream->is_open()) {
+            delete ownedStream;
+            ownedStream = nullptr;
+            throw std::runtime_error("cannot open file");
+        }
+        in = ownedStream;
+    }
+
+    std::size_t readBuffered(T* out, std::size_t max) {
+        std::size_t total = 0;
+        while (total < max && !endReached) {
+            const char* data = type == SourceType::Mapped ? mapped : buffer.get();
+            const char* cursor = data + bufferBegin;
+            std::size_t want = max - total;
+            // индекс строится по ходу чтения: разбор останавливается на каждой
+            // контрольной точке, чтобы записать её смещение
+            std::size_t nextCheckpoint = 0;
+            bool indexing = index && !index->IsComplete();
+            if (indexing) {
+                nextCheckpoint = static_cast<std::size_t>(index->GetCheckpointCount()) * index->GetStride();
+                if (nextCheckpoint - position < want) want = nextCheckpoint - position;
+            }
+            std::size_t produced = 0;
+            bool ok = blockDeserializer(cursor, data + bufferEnd, inputDone, out + total, want, produced);
+            bufferBegin = static_cast<std::size_t>(cursor - data);
+            total += produced;
+            position += produced;
+            if (indexing && position == nextCheckpoint) {
+                index->AddCheckpoint(streamOffset + bufferBegin);
+            }
+            if (!ok) {
+                endReached = true;
+            } else if (produced < want) {
+                // разобрано всё, что можно; на последнем куске это конец потока
+                if (inputDone) {
+                    endReached = true;
+                    if (indexing) {
+                        index->Complete(position, streamOffset + bufferEnd);
+                    }
+                } else {
+                    refill();
+                }
+            }
+        }
+        return total;
+    }
+
+    // Seek для текстового входа: от ближайшей контрольной точки индекса (без
+    // индекса — от начала отображённого файла) дочитать до записи target.
+    void seekText(std::size_t target) {
+        std::size_t offset = 0;
+        std::size_t record = 0;
+        if (index) {
+            int checkpoint = static_cast<int>(target / static_cast<std::size_t>(index->GetStride()));
+            if (checkpoint >= index->GetCheckpointCount()) {
+                checkpoint = index->GetCheckpointCount() - 1;
+            }
+            offset = index->GetOffset(checkpoint);
+            record = static_cast<std::size_t>(checkpoint) * index->GetStride();
+        }
+        if (type == SourceType::Mapped) {
+            SeekByte(offset, record);
+        } else {
+            in->clear();
+            in->seekg(inputBase + static_cast<std::streamoff>(offset));
+            if (!*in) {
+                throw std::runtime_error("input stream is not seekable");
+            }
+            streamOffset = offset;
+            bufferBegin = 0;
+            bufferEnd = 0;
+            inputDone = false;
+            position = record;
+            endReached = false;
+        }
+        T skipped[256];
+        while (position < target) {
+            std::size_t want = target - position < 256 ? target - position : 256;
+            if (readBuffered(skipped, want) < want) break;
+        }
+    }
+
+    // Размер входа в байтах (для сверки с индексом).
+    std::size_t sourceSize() {
+        if (type == SourceType::Mapped) {
+            return bufferEnd;
+        }
+        in->seekg(0, std::ios::end);
+        std::streampos end = in->tellg();
+        in->seekg(inputBase);
+        return static_cast<std::size_t>(end - inputBase);
+    }
+
+    // Сдвинуть неразобранный хвост в начало буфера и дочитать вход.
+    void refill() {
+        if (!in) {
+            inputDone = true;
+            return;
+        }
+        streamOffset += bufferBegin;
+        std::size_t tail = bufferEnd - bufferBegin;
+        if (tail == bufferSize) {
+            std::size_t newSize = bufferSize == 0 ? kReadBufferSize : bufferSize * 2;
+            std::unique_ptr<char[]> grown(new char[newSize]);
+            if (tail > 0) std::memcpy(grown.get(), buffer.get() + bufferBegin, tail);
+            buffer = std::move(grown);
+            bufferSize = newSize;
+        } else if (tail > 0 && bufferBegin > 0) {
+            std::memmove(buffer.get(), buffer.get() + bufferBegin, tail);
+        }
+        bufferBegin = 0;
+        bufferEnd = tail;
+        in->read(buffer.get() + bufferEnd, static_cast<std::streamsize>(bufferSize - bufferEnd));
+        bufferEnd += static_cast<std::size_t>(in->gcount());
+        if (!*in) {
+            inputDone = true;
+        }
+    }
 };
 
 // ------------------------ WriteOnlyStream ------------------------
@@ -164,30 +533,35 @@ template<typename T>
 class WriteOnlyStream {
 public:
     using Serializer = std::function<void(std::ostream&, const T&)>;
+    // Дописать в buffer представление count значений (например, FormatTextBlock).
+    using BlockSerializer = std::function<void(std::string& buffer, const T* values, std::size_t count)>;
 
     // Stream to existing std::ostream (e.g. std::cout)
     WriteOnlyStream(std::ostream& output, Serializer s)
         : out(&output),
           ownedStream(nullptr),
           serializer(s),
+          blockSerializer(),
+          position(0),
+          opened(true) {}
+
+    WriteOnlyStream(std::ostream& output, BlockSerializer s)
+        : out(&output),
+          ownedStream(nullptr),
+          serializer(),
+          blockSerializer(s),
           position(0),
           opened(true) {}
 
     // Stream to file
     WriteOnlyStream(const std::string& fileName, Serializer s)
-        : out(nullptr),
-          ownedStream(new std::ofstream(fileName)),
-          serializer(s),
-          position(0),
-          opened(false)
-    {
-        if (!ownedStream->is_open()) {
-            delete ownedStream;
-            ownedStream = nullptr;
-            throw std::runtime_error("cannot open file");
-        }
-        out = ownedStream;
-        opened = true;
+        : WriteOnlyStream(fileName) {
+        serializer = s;
+    }
+
+    WriteOnlyStream(const std::string& fileName, BlockSerializer s)
+        : WriteOnlyStream(fileName) {
+        blockSerializer = s;
     }
 
     ~WriteOnlyStream() {
@@ -214,6 +588,10 @@ public:
     }
 
     void Write(const T& value) {
+        if (!serializer && blockSerializer) {
+            WriteBlock(&value, 1);
+            return;
+        }
         if (!opened || !out || !serializer) {
             throw std::runtime_error("stream is not open for writing");
         }
@@ -221,12 +599,50 @@ public:
         ++position;
     }
 
+    // Записать count значений; с BlockSerializer — одним вызовом
+    // ostream::write на весь блок.
+    void WriteBlock(const T* values, std::size_t count) {
+        if (!opened || !out || (!serializer && !blockSerializer)) {
+            throw std::runtime_error("stream is not open for writing");
+        }
+        if (!blockSerializer) {
+            for (std::size_t i = 0; i < count; ++i) {
+                serializer(*out, values[i]);
+                ++position;
+            }
+            return;
+        }
+        pending.clear();
+        blockSerializer(pending, values, count);
+        out->write(pending.data(), static_cast<std::streamsize>(pending.size()));
+        position += count;
+    }
+
 private:
     std::ostream* out;
     std::ofstream* ownedStream;
     Serializer serializer;
+    BlockSerializer blockSerializer;
+    std::string pending;        // буфер WriteBlock, ёмкость переиспользуется
     std::size_t position;
     bool opened;
+
+    explicit WriteOnlyStream(const std::string& fileName)
+        : out(nullptr),
+          ownedStream(new std::ofstream(fileName)),
+          serializer(),
+          blockSerializer(),
+          position(0),
+          opened(false)
+    {
+        if (!ownedStream->is_open()) {
+            delete ownedStream;
+            ownedStream = nullptr;
+            throw std::runtime_error("cannot open file");
+        }
+        out = ownedStream;
+        opened = true;
+    }
 };
 
 #endif
\ No newline at end of file
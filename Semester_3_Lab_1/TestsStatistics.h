@@ -1,15 +1,138 @@
 #ifndef TESTS_STATISTICS_H
 #define TESTS_STATISTICS_H
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <sstream>
+#include <thread>
+#include <vector>
+#include <stdexcept>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <limits>
 
 #include "sequence.h"
+#include "Lists.h"
+#include "UnrolledList.h"
 #include "LazySequence.h"
 #include "Streams.h"
+#include "BinaryStreams.h"
+#include "AsyncStreams.h"
+#include "MappedFile.h"
+#include "OffsetIndex.h"
 #include "OnlineStatistics.h"
+#include "PartitionedIngest.h"
+#include "AllocTracking.h"
+
+// --------------- UnrolledList tests ---------------
+
+void TestUnrolledListSequence() {
+    // ref — ожидаемое содержимое; вставки в середину делят полные узлы
+    const int n = 100;
+    int ref[n + 3];
+    MutableUnrolledListSequence<int> seq;
+    for (int i = 0; i < n; ++i) {
+        assert(seq.Append(i) == &seq);
+        ref[i] = i;
+    }
+    seq.InsertAt(37, -1);
+    seq.Prepend(-2);
+    seq.InsertAt(50, -3);
+
+    int expected[n + 3];
+    int k = 0;
+    expected[k++] = -2;
+    for (int i = 0; i < n; ++i) {
+        if (i == 37) expected[k++] = -1;
+        if (k == 50) expected[k++] = -3;
+        expected[k++] = ref[i];
+    }
+    assert(seq.GetLength() == n + 3);
+    for (int i = 0; i < n + 3; ++i) assert(seq.Get(i) == expected[i]);
+
+    int i = 0;
+    for (int v : seq) {
+        (void)v;
+        assert(v == expected[i]);
+        ++i;
+    }
+    assert(i == n + 3);
+    (void)expected;
+
+    const Sequence<int>& base = seq;
+    auto cur = base.CreateCursor(60);
+    assert(cur->Current() == expected[60]);
+
+    Sequence<int>* sub = seq.GetSubsequence(49, 51);
+    assert(sub->GetLength() == 3 && sub->Get(1) == -3);
+    delete sub;
+
+    // неизменяемая версия возвращает новую последовательность
+    ImmutableUnrolledListSequence<int> frozen(ref, 3);
+    Sequence<int>* grown = frozen.Append(3);
+    assert(grown != &frozen && frozen.GetLength() == 3 && grown->GetLast() == 3);
+    delete grown;
+}
+
+// --------------- ImmutableArraySequence tests ---------------
+
+void TestPersistentImmutableArraySequence() {
+    // цепочка версий: каждая следующая — Append к предыдущей, старые не меняются
+    const int n = 40000; // > 32 * 32 * 32 + 32: дерево трижды растёт в высоту
+    Sequence<int>* versions[4] = {new ImmutableArraySequence<int>(), nullptr, nullptr, nullptr};
+    Sequence<int>* cur = versions[0];
+    int checkpoints[3] = {33, 1057, n};
+    int next = 0;
+    for (int i = 0; i < n; ++i) {
+        Sequence<int>* grown = cur->Append(i);
+        if (cur != versions[next]) delete cur;
+        cur = grown;
+        if (i + 1 == checkpoints[next]) versions[++next] = cur;
+    }
+    assert(versions[0]->GetLength() == 0);
+    for (int v = 1; v <= 3; ++v) {
+        int len = checkpoints[v - 1];
+        assert(versions[v]->GetLength() == len);
+        assert(versions[v]->GetFirst() == 0 && versions[v]->GetLast() == len - 1);
+        for (int i = 0; i < len; i += 97) assert(versions[v]->Get(i) == i);
+    }
+
+    // пакетная сборка даёт то же, что и серия Append; обход курсором идёт по листам
+    int* data = new int[n];
+    for (int i = 0; i < n; ++i) data[i] = i;
+    ImmutableArraySequence<int> bulk(data, n);
+    delete[] data;
+    long long sum = 0;
+    for (int x : static_cast<const Sequence<int>&>(bulk)) sum += x;
+    assert(sum == 1LL * n * (n - 1) / 2);
+    auto cursor = bulk.CreateCursor(31);
+    assert(cursor->Current() == 31);
+    cursor->Next();
+    assert(cursor->Current() == 32);
+
+    // Set меняет только новую версию — и в дереве, и в хвосте
+    ImmutableArraySequence<int>* patched = bulk.Set(5, -5);
+    ImmutableArraySequence<int>* patchedTail = patched->Set(n - 1, -1);
+    assert(bulk.Get(5) == 5 && patched->Get(5) == -5 && patchedTail->Get(5) == -5);
+    assert(patched->GetLast() == n - 1 && patchedTail->GetLast() == -1);
+    delete patched;
+    delete patchedTail;
+
+    Sequence<int>* both = versions[1]->Concat(*versions[1]);
+    assert(both->GetLength() == 66 && both->Get(33) == 0 && both->Get(65) == 32);
+    Sequence<int>* middle = both->InsertAt(33, 100);
+    assert(middle->GetLength() == 67 && middle->Get(33) == 100 && middle->Get(34) == 0);
+    Sequence<int>* window = middle->GetSubsequence(32, 34);
+    assert(window->GetLength() == 3 && window->Get(0) == 32 && window->Get(2) == 0);
+    delete window;
+    delete middle;
+    delete both;
+
+    for (Sequence<int>* v : versions) delete v;
+}
 
 // --------------- LazySequence tests ---------------
 
@@ -72,6 +195,542 @@ void TestLazySequenceBasic() {
     assert(conc->Get(seq.GetLength()) == 100);
     assert(conc->Get(seq.GetLength() + 2) == 300);
     delete conc;
+
+    // окно и конкатенация ленивых последовательностей не запускают генератор
+    LazySequence<int> big(gen, 1000000);
+    prevCalls = generatorCalls;
+    Sequence<int>* bigConc = big.Concat(big);
+    Sequence<int>* window = bigConc->GetSubsequence(999998, 1000001);
+    assert(generatorCalls == prevCalls);
+    assert(bigConc->GetLength() == 2000000 && window->GetLength() == 4);
+    assert(window->Get(2) == 0);
+    assert(generatorCalls == prevCalls + 1);
+    delete window;
+    delete bigConc;
+}
+
+void TestLazySequenceBatch() {
+    // блочный генератор: f(i) = 3 * i, блоки по 4096
+    int batchCalls = 0;
+    auto batch = [&batchCalls](const LazySequence<int>&, int start, int* out, int count) {
+        ++batchCalls;
+        for (int k = 0; k < count; ++k) out[k] = 3 * (start + k);
+    };
+
+    LazySequence<int> seq(batch, 10000);
+    assert(seq.GetMaterializedCount() == 0);
+    assert(seq.Get(0) == 0);
+    assert(batchCalls == 1 && seq.GetMaterializedCount() == 4096);
+    assert(seq.Get(4095) == 3 * 4095 && batchCalls == 1);
+    assert(seq.Get(5000) == 15000);
+    assert(batchCalls == 2 && seq.GetMaterializedCount() == 8192);
+    // последний блок обрезается по длине
+    assert(seq.GetLast() == 3 * 9999);
+    assert(batchCalls == 3 && seq.GetMaterializedCount() == 10000);
+
+    // копия продолжает генерацию тем же генератором
+    LazySequence<int> small(batch, 10, 4);
+    LazySequence<int> copy(small);
+    assert(copy.Get(9) == 27 && copy.GetMaterializedCount() == 10);
+    assert(small.GetMaterializedCount() == 0);
+
+    // рекуррентный блочный генератор: предыдущие блоки через Get, текущий через out
+    LazySequence<long long> fib([](const LazySequence<long long>& s, int start, long long* out, int count) {
+        for (int k = 0; k < count; ++k) {
+            int i = start + k;
+            long long a = i < 1 ? 0 : (k >= 1 ? out[k - 1] : s.Get(i - 1));
+            long long b = i < 2 ? 0 : (k >= 2 ? out[k - 2] : s.Get(i - 2));
+            out[k] = i < 2 ? i : a + b;
+        }
+    }, 90, 16);
+    assert(fib.Get(89) == 1779979416004714189LL);
+
+    // поэлементный генератор через адаптер видит предыдущие элементы
+    LazySequence<long long> fibElem([](const LazySequence<long long>& s, int i) -> long long {
+        return i < 2 ? i : s.Get(i - 1) + s.Get(i - 2);
+    }, 90);
+    assert(fibElem.Get(89) == fib.Get(89));
+    assert(fibElem.GetMaterializedCount() == 90);
+
+    // обращение генератора к ещё не готовому элементу — ошибка, а не рекурсия
+    LazySequence<int> selfRef([](const LazySequence<int>& s, int start, int* out, int count) {
+        for (int k = 0; k < count; ++k) out[k] = s.Get(start + k);
+    }, 8, 4);
+    bool thrown = false;
+    try { selfRef.Get(0); } catch (const std::logic_error&) { thrown = true; }
+    assert(thrown && selfRef.GetMaterializedCount() == 0);
+
+    // исключение в генераторе не засчитывает недописанный блок
+    bool fail = true;
+    LazySequence<int> flaky([&fail](const LazySequence<int>&, int start, int* out, int count) {
+        if (fail) throw std::runtime_error("generator failed");
+        for (int k = 0; k < count; ++k) out[k] = start + k;
+    }, 8, 4);
+    thrown = false;
+    try { flaky.Get(1); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown && flaky.GetMaterializedCount() == 0);
+    (void)thrown;
+    fail = false;
+    assert(flaky.Get(5) == 5 && flaky.GetMaterializedCount() == 8);
+
+    bool badBlock = false;
+    try { LazySequence<int> bad(batch, 10, 0); } catch (const std::invalid_argument&) { badBlock = true; }
+    assert(badBlock);
+    (void)badBlock;
+}
+
+void TestBlockCache() {
+    BlockCache<int> cache(4, 3);
+    assert(cache.Find(0) == nullptr);
+    for (int key = 0; key < 3; ++key) {
+        int* block = cache.Insert(key * 100);
+        for (int k = 0; k < 4; ++k) block[k] = key * 100 + k;
+    }
+    assert(cache.GetCachedBlocks() == 3);
+
+    // 0 становится свежим, вытесняется 100
+    assert(cache.Find(0)[3] == 3);
+    cache.Insert(300)[0] = 300;
+    assert(cache.Find(100) == nullptr && cache.Find(200)[1] == 201 && cache.Find(300)[0] == 300);
+    assert(cache.Find(0)[0] == 0);
+
+    cache.Erase(200);
+    assert(cache.Find(200) == nullptr && cache.GetCachedBlocks() == 2);
+    cache.Insert(400);
+    assert(cache.Find(0) && cache.Find(300) && cache.Find(400) && cache.GetCachedBlocks() == 3);
+
+    // много ключей с коллизиями в таблице: удаление не должно терять цепочки
+    BlockCache<int> big(1, 64);
+    for (int key = 0; key < 1000; ++key) {
+        big.Insert(key)[0] = key;
+        if (key >= 64) assert(big.Find(key - 64) == nullptr);
+        // обход по возрастанию не меняет относительный порядок LRU
+        if (key % 50 == 0) {
+            for (int k = key < 63 ? 0 : key - 63; k <= key; ++k) assert(big.Find(k)[0] == k);
+        }
+    }
+    big.Clear();
+    assert(big.GetCachedBlocks() == 0 && big.Find(999) == nullptr);
+}
+
+void TestLazySequenceRandomAccess() {
+    using Lazy = LazySequence<long long>;
+    long long generated = 0;
+    Lazy::BatchGenerator square = [&generated](const Lazy&, int start, long long* out, int count) {
+        generated += count;
+        for (int k = 0; k < count; ++k) out[k] = 1LL * (start + k) * (start + k);
+    };
+
+    const int n = 1000000000;
+    Lazy seq(square, n, Lazy::Access::Random, 64, 4);
+    assert(seq.GetAccess() == Lazy::Access::Random);
+    assert(seq.Get(n - 1) == 1LL * (n - 1) * (n - 1));
+    assert(generated == 64 && seq.GetMaterializedCount() == 0);
+    assert(seq.GetFirst() == 0 && seq.Get(63) == 63 * 63 && generated == 128);
+
+    // кэш ограничен четырьмя блоками: память не растёт с числом обращений
+    for (int i = 0; i < 100; ++i) assert(seq.Get(i * 1000003) == 1LL * i * 1000003 * i * 1000003);
+    assert(seq.GetCachedBlocks() == 4);
+    long long before = generated;
+    seq.Get(99 * 1000003);
+    assert(generated == before);
+    (void)before;
+
+    // последний блок короче blockSize
+    Lazy tail(square, 100, Lazy::Access::Random, 64, 2);
+    assert(tail.Get(99) == 99 * 99);
+
+    // поэлементный генератор в режиме Random
+    int calls = 0;
+    LazySequence<int> elem([&calls](const LazySequence<int>&, int i) { ++calls; return i % 7; },
+                           1 << 30, LazySequence<int>::Access::Random, 8, 2);
+    assert(elem.Get(1000) == 1000 % 7 && calls == 8);
+    Sequence<int>* window = elem.GetSubsequence(1 << 20, (1 << 20) + 3);
+    assert(window->Get(3) == ((1 << 20) + 3) % 7);
+    delete window;
+
+    // копия и присваивание получают свой пустой кэш
+    Lazy copy(seq);
+    assert(copy.GetCachedBlocks() == 0 && copy.Get(5) == 25);
+    Lazy assigned;
+    assigned = seq;
+    assert(assigned.GetAccess() == Lazy::Access::Random && assigned.Get(n - 2) == 1LL * (n - 2) * (n - 2));
+
+    // чтение незакэшированного элемента изнутри генератора — ошибка
+    LazySequence<int> dependent([](const LazySequence<int>& s, int i) { return i == 0 ? 0 : s.Get(i - 1) + 1; },
+                                1000, LazySequence<int>::Access::Random, 16, 4);
+    bool thrown = false;
+    try { dependent.Get(500); } catch (const std::logic_error&) { thrown = true; }
+    assert(thrown && dependent.GetCachedBlocks() == 0);
+    (void)thrown;
+
+    // и соседнего элемента того же, ещё не заполненного блока
+    LazySequence<std::string> sameBlock([](const LazySequence<std::string>& s, int i) {
+                                            return i == 0 ? "x" + s.Get(1) : std::string("y");
+                                        },
+                                        64, LazySequence<std::string>::Access::Random, 8, 2);
+    bool inFlight = false;
+    try { sameBlock.Get(0); } catch (const std::logic_error&) { inFlight = true; }
+    assert(inFlight && sameBlock.GetCachedBlocks() == 0);
+    (void)inFlight;
+    assert(sameBlock.Get(9) == "y");
+
+    bool badCache = false;
+    try { Lazy bad(square, 10, Lazy::Access::Random, 4, 0); } catch (const std::invalid_argument&) { badCache = true; }
+    assert(badCache);
+    (void)badCache;
+
+    // последовательный режим больше не резервирует всю длину сразу
+    Lazy prefix(square, n);
+    assert(prefix.Get(10) == 100 && prefix.GetMaterializedCount() == Lazy::kDefaultBlockSize);
+}
+
+void TestLazySequenceUnbounded() {
+    using Lazy = LazySequence<long long>;
+    const long long mod = 1000000007;
+
+    // Фибоначчи по модулю: генератор смотрит назад на два элемента
+    Lazy fib([mod](const Lazy& s, long long i) -> long long {
+        return i < 2 ? i : (s.GetAt(i - 1) + s.GetAt(i - 2)) % mod;
+    }, Lazy::Unbounded{2});
+    assert(fib.IsUnbounded() && fib.GetLength() == std::numeric_limits<int>::max());
+    assert(fib.GetAt(10) == 55 && fib.GetMaterializedCount() == 11);
+    assert(fib.Get(89) == 1779979416004714189LL % mod);
+
+    // дальше по последовательности память не растёт
+    {
+        AllocScope scope;
+        long long value = fib.GetAt(2000000);
+        assert(value == fib.GetAt(2000000));
+        (void)value;
+        if constexpr (AllocTrackingEnabled()) {
+            assert(scope.Allocations() == 0);
+        }
+    }
+    assert(fib.GetOldestRetained() > 1000000);
+    bool dropped = false;
+    try { fib.GetAt(10); } catch (const std::out_of_range&) { dropped = true; }
+    assert(dropped);
+    (void)dropped;
+    // последние window элементов перед текущим доступны
+    assert(fib.GetAt(1999999) >= 0 && fib.GetAt(1999998) >= 0);
+
+    // блочный генератор за пределами int: индексы 64-битные
+    long long calls = 0;
+    Lazy counter([&calls](const Lazy&, long long start, long long* out, int count) {
+        ++calls;
+        for (int k = 0; k < count; ++k) out[k] = start + k;
+    }, Lazy::Unbounded{0}, 1 << 16);
+    assert(counter.GetAt(5) == 5 && calls == 1 && counter.GetMaterializedCount() == (1 << 16));
+    assert(counter.GetAt(1LL << 22) == (1LL << 22));
+    assert(counter.GetOldestRetained() > (1LL << 21));
+
+    // копия продолжает с того же места независимо
+    Lazy copy(fib);
+    assert(copy.GetAt(2000001) == fib.GetAt(2000001));
+
+    // окно на неограниченной последовательности работает, операции над длиной — нет
+    Sequence<long long>* window = fib.GetSubsequence(2000002, 2000005);
+    assert(window->GetLength() == 4 && window->Get(0) == fib.GetAt(2000002));
+    delete window;
+    bool unsupported = false;
+    try { delete fib.Append(1); } catch (const std::logic_error&) { unsupported = true; }
+    assert(unsupported);
+    unsupported = false;
+    try { fib.GetLast(); } catch (const std::logic_error&) { unsupported = true; }
+    assert(unsupported);
+    (void)unsupported;
+
+    // генератор, заглядывающий дальше окна, получает out_of_range
+    Lazy farBack([](const Lazy& s, long long i) -> long long { return i < 1000 ? i : s.GetAt(i - 1000); },
+                 Lazy::Unbounded{4});
+    bool tooFar = false;
+    try { farBack.GetAt(5000); } catch (const std::out_of_range&) { tooFar = true; }
+    assert(tooFar);
+    (void)tooFar;
+
+    bool badWindow = false;
+    try { Lazy bad([](const Lazy&, long long) { return 0LL; }, Lazy::Unbounded{-1}); }
+    catch (const std::invalid_argument&) { badWindow = true; }
+    assert(badWindow);
+    (void)badWindow;
+}
+
+void TestLazySequenceParallel() {
+    using Lazy = LazySequence<long long>;
+    std::atomic<long long> generated{0};
+    Lazy::BatchGenerator cube = [&generated](const Lazy&, long long start, long long* out, int count) {
+        generated += count;
+        for (int k = 0; k < count; ++k) out[k] = (start + k) * (start + k) % 1000003 * (start + k);
+    };
+
+    const int n = 300001;
+    Lazy seq(cube, n, Lazy::Access::Indexed, 4096);
+    assert(seq.GetAccess() == Lazy::Access::Indexed);
+    assert(seq.Get(7) == 7LL * 7 % 1000003 * 7);
+    seq.MaterializeParallel(n, 4);
+    assert(seq.GetMaterializedCount() == n);
+    // каждый элемент сгенерирован ровно один раз
+    assert(generated == n);
+    for (long long i = 0; i < n; i += 997) assert(seq.Get(static_cast<int>(i)) == i * i % 1000003 * i);
+    assert(seq.GetLast() == 300000LL * 300000 % 1000003 * 300000);
+
+    // поэлементный генератор по индексу тоже годится
+    std::atomic<int> calls{0};
+    LazySequence<int> elem([&calls](const LazySequence<int>&, long long i) -> int { ++calls; return static_cast<int>(i % 13); },
+                           100000, LazySequence<int>::Access::Indexed);
+    elem.MaterializeParallel(100000, 3);
+    assert(calls == 100000 && elem.Get(99999) == 99999 % 13);
+
+    // генератор без пометки Indexed материализуется последовательно
+    LazySequence<long long> fib([](const LazySequence<long long>& s, long long i) -> long long {
+        return i < 2 ? i : (s.GetAt(i - 1) + s.GetAt(i - 2)) % 1000000007;
+    }, 50000);
+    fib.MaterializeParallel(50000, 8);
+    assert(fib.GetMaterializedCount() == 50000 && fib.Get(10) == 55);
+
+    // исключение из любого потока доходит до вызывающего, префикс не растёт
+    LazySequence<int> failing([](const LazySequence<int>&, long long start, int* out, int count) {
+        if (start >= 100000) throw std::runtime_error("generator failed");
+        for (int k = 0; k < count; ++k) out[k] = 1;
+    }, 200000, LazySequence<int>::Access::Indexed, 1024);
+    bool thrown = false;
+    try { failing.MaterializeParallel(200000, 4); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown && failing.GetMaterializedCount() == 0);
+    (void)thrown;
+    assert(failing.Get(5) == 1);
+
+    bool unsupported = false;
+    Lazy random(cube, n, Lazy::Access::Random);
+    try { random.MaterializeParallel(10); } catch (const std::logic_error&) { unsupported = true; }
+    assert(unsupported);
+    (void)unsupported;
+}
+
+void TestLazySequenceConcurrentReaders() {
+    using Lazy = LazySequence<long long>;
+    const int n = 200000;
+    const long long mod = 1000000007;
+
+    // рекуррентный генератор: потоку-производителю нужны свои же свежие элементы
+    std::atomic<int> calls{0};
+    Lazy fib([&calls, mod](const Lazy& s, long long i) -> long long {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        return i < 2 ? i : (s.GetAt(i - 1) + s.GetAt(i - 2)) % mod;
+    }, n);
+    fib.EnableConcurrentReads();
+    assert(fib.IsConcurrent());
+
+    Lazy reference([mod](const Lazy& s, long long i) -> long long {
+        return i < 2 ? i : (s.GetAt(i - 1) + s.GetAt(i - 2)) % mod;
+    }, n);
+    reference.Get(n - 1);
+
+    // читатели идут с разной скоростью и с разных мест; каждый проверяет всё, что прочёл
+    const int readers = 4;
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> pool;
+    for (int r = 0; r < readers; ++r) {
+        pool.emplace_back([&, r]() {
+            for (int i = r * 1000; i < n; i += 1 + r) {
+                if (fib.Get(i) != reference.Get(i)) mismatches.fetch_add(1);
+            }
+            if (fib.Get(n - 1 - r) != reference.Get(n - 1 - r)) mismatches.fetch_add(1);
+        });
+    }
+    for (std::thread& t : pool) t.join();
+    assert(mismatches == 0);
+    // каждый элемент сгенерирован ровно один раз
+    assert(calls == n && fib.GetMaterializedCount() == n);
+
+    // блочный генератор, производителем может оказаться любой поток
+    std::atomic<long long> generated{0};
+    LazySequence<int> blocks([&generated](const LazySequence<int>&, long long start, int* out, int count) {
+        generated.fetch_add(count);
+        for (int k = 0; k < count; ++k) out[k] = static_cast<int>((start + k) * 3);
+    }, n, 1024);
+    blocks.EnableConcurrentReads();
+    std::atomic<long long> total{0};
+    pool.clear();
+    for (int r = 0; r < readers; ++r) {
+        pool.emplace_back([&]() {
+            total.fetch_add(PipelineFrom(blocks).Reduce(0LL, [](long long acc, int v) { return acc + v; }));
+        });
+    }
+    for (std::thread& t : pool) t.join();
+    assert(total == readers * (3LL * n * (n - 1) / 2));
+    assert(generated == n);
+
+    // исключение достаётся тому потоку, который был производителем, остальные
+    // продолжают попытки и тоже получают его
+    LazySequence<int> failing([](const LazySequence<int>&, long long start, int* out, int count) {
+        if (start + count > 5000) throw std::runtime_error("generator failed");
+        for (int k = 0; k < count; ++k) out[k] = 1;
+    }, 10000, 1000);
+    failing.EnableConcurrentReads();
+    std::atomic<int> failures{0};
+    pool.clear();
+    for (int r = 0; r < readers; ++r) {
+        pool.emplace_back([&]() {
+            try { failing.Get(9999); } catch (const std::runtime_error&) { failures.fetch_add(1); }
+        });
+    }
+    for (std::thread& t : pool) t.join();
+    assert(failures == readers && failing.GetMaterializedCount() == 0);
+    assert(failing.Get(4999) == 1 && failing.GetMaterializedCount() == 5000);
+
+    bool unsupported = false;
+    Lazy random([](const Lazy&, long long i) { return i; }, 10, Lazy::Access::Random);
+    try { random.EnableConcurrentReads(); } catch (const std::logic_error&) { unsupported = true; }
+    assert(unsupported);
+    (void)unsupported;
+}
+
+// --------------- LazyPipeline tests ---------------
+
+void TestLazyPipeline() {
+    int generatorCalls = 0;
+    LazySequence<int> seq([&generatorCalls](const LazySequence<int>&, long long i) -> int {
+        ++generatorCalls;
+        return static_cast<int>(i);
+    }, 1000);
+
+    // построение конвейера ничего не вычисляет
+    auto evenSquares = seq.Where([](int x) { return x % 2 == 0; })
+                          .Map([](int x) { return 1LL * x * x; });
+    assert(generatorCalls == 0);
+
+    // Take останавливает проход: сгенерированы только нужные элементы
+    long long sum = evenSquares.Take(3).Reduce(0LL, [](long long acc, long long x) { return acc + x; });
+    assert(sum == 0 + 4 + 16 && generatorCalls == 5);
+    (void)sum;
+
+    // конвейер можно прогнать повторно
+    assert(evenSquares.Count() == 500);
+    assert(evenSquares.Count() == 500);
+
+    // Skip источника перескакивает индексы
+    Sequence<int>* tail = seq.Skip(995).ToArraySequence();
+    assert(tail->GetLength() == 5 && tail->Get(0) == 995 && tail->Get(4) == 999);
+    delete tail;
+    Sequence<int>* middle = seq.Map([](int x) { return x + 1; }).Skip(10).Take(3).ToArraySequence();
+    assert(middle->GetLength() == 3 && middle->Get(0) == 11 && middle->Get(2) == 13);
+    delete middle;
+    assert(seq.Skip(2000).Count() == 0 && seq.Take(0).Count() == 0);
+
+    // Zip заканчивается по более короткому входу
+    int arr[4] = {10, 20, 30, 40};
+    MutableArraySequence<int> short4(arr, 4);
+    long long dot = seq.Zip(PipelineFrom(short4), [](int a, int b) { return 1LL * a * b; })
+                       .Reduce(0LL, [](long long acc, long long x) { return acc + x; });
+    assert(dot == 0 * 10 + 1 * 20 + 2 * 30 + 3 * 40);
+    (void)dot;
+    auto pairs = PipelineFrom(short4).Zip(PipelineFrom(short4).Skip(1));
+    assert(pairs.Count() == 3);
+    pairs.ForEach([](const std::pair<int, int>& p) { assert(p.second == p.first + 10); (void)p; });
+
+    // неограниченный источник + Take, результат сразу в OnlineStatistics
+    LazySequence<double> readings([](const LazySequence<double>&, long long i) -> double {
+        return static_cast<double>(i % 10);
+    }, LazySequence<double>::Unbounded{0});
+    OnlineStatistics<double> stats(true, true, true, false);
+    readings.Skip(5).Take(1000).AddTo(stats);
+    assert(stats.GetCount() == 1000);
+    assert(std::fabs(stats.GetMean() - 4.5) < 1e-9);
+    assert(stats.GetMin() == 0.0 && stats.GetMax() == 9.0);
+
+    // по уже материализованному источнику проход не выделяет память
+    MutableArraySequence<int> plain;
+    for (int i = 0; i < 100; ++i) plain.Append(i);
+    {
+        AllocScope scope;
+        long long odd = PipelineFrom(plain).Where([](int x) { return x % 2 == 1; })
+                            .Map([](int x) { return static_cast<long long>(x); })
+                            .Reduce(0LL, [](long long acc, long long x) { return acc + x; });
+        assert(odd == 2500);
+        (void)odd;
+        if constexpr (AllocTrackingEnabled()) {
+            assert(scope.Allocations() == 0);
+        }
+    }
+
+    bool thrown = false;
+    try { seq.Take(-1); } catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+    (void)thrown;
+}
+
+// --------------- Sequence views tests ---------------
+
+void TestSequenceViews() {
+    int a[4] = {1, 2, 3, 4};
+    int b[3] = {10, 20, 30};
+    MutableArraySequence<int> left(a, 4);
+    MutableArraySequence<int> right(b, 3);
+
+    // окно над массивом: без копии, с непрерывным буфером источника
+    Sequence<int>* slice = left.GetSubsequence(1, 2);
+    std::span<const int> span;
+    assert(slice->GetLength() == 2 && slice->Get(0) == 2 && slice->GetLast() == 3);
+    assert(slice->TryGetContiguous(span) && span.data() == left.AsSpan().data() + 1);
+
+    // конкатенация — представление, видит изменения источников
+    Sequence<int>* both = left.Concat(right);
+    assert(both->GetLength() == 7 && both->Get(4) == 10);
+    left[0] = 100;
+    assert(both->GetFirst() == 100);
+
+    int expected[7] = {100, 2, 3, 4, 10, 20, 30};
+    int i = 0;
+    for (int x : *both) {
+        (void)x;
+        assert(x == expected[i]);
+        ++i;
+    }
+    assert(i == 7);
+    (void)expected;
+    auto cursor = both->CreateCursor(3);
+    assert(cursor->Current() == 4);
+    cursor->Next();
+    assert(cursor->Current() == 10);
+
+    // окно поперёк границы и окно внутри половины
+    Sequence<int>* across = both->GetSubsequence(2, 5);
+    assert(across->GetLength() == 4 && across->Get(1) == 4 && across->Get(2) == 10);
+    Sequence<int>* inner = both->GetSubsequence(5, 6);
+    assert(inner->ViewDepth() == 1 && inner->Get(0) == 20);
+
+    // изменяющая операция материализует представление: новый владелец,
+    // само представление не меняется
+    Sequence<int>* grown = both->Append(40);
+    assert(grown != both);
+    assert(grown->GetLength() == 8 && grown->ViewDepth() == 0 && grown->GetLast() == 40);
+    assert(both->GetLength() == 7);
+
+    // Clone — независимая копия, а не ещё одно представление
+    Sequence<int>* copy = across->Clone();
+    assert(copy->ViewDepth() == 0 && copy->GetLength() == 4);
+    left[3] = -4;
+    assert(across->Get(1) == -4 && copy->Get(1) == 4);
+    left[3] = 4;
+    delete copy;
+
+    // глубокая цепочка конкатенаций сплющивается, не превышая kMaxDepth
+    Sequence<int>* chain[40];
+    chain[0] = right.Concat(right);
+    for (int k = 1; k < 40; ++k) {
+        chain[k] = chain[k - 1]->Concat(right);
+        assert(chain[k]->ViewDepth() <= ConcatSequence<int>::kMaxDepth);
+        assert(chain[k]->GetLength() == 3 * (k + 2));
+    }
+    assert(chain[39]->Get(3 * 41 - 1) == 30);
+    for (Sequence<int>* c : chain) delete c;
+
+    delete grown;
+    delete inner;
+    delete across;
+    delete both;
+    delete slice;
 }
 
 // --------------- Streams tests ---------------
@@ -98,6 +757,107 @@ void TestReadOnlyStreamFromSequence() {
     assert(!ok2);
 }
 
+void TestReadOnlyStreamFromGrowingSequence() {
+    // Append на месте перевыделяет буфер между чтениями: поток не должен
+    // читать через устаревший курсор
+    int arr[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    MutableArraySequence<int> array(arr, 10);
+    ReadOnlyStream<int> fromArray(&array);
+    int x = 0;
+    for (int i = 0; i < 10; ++i) assert(fromArray.TryRead(x) && x == i);
+    assert(!fromArray.TryRead(x));
+    for (int i = 10; i < 110; ++i) array.Append(i);
+    for (int i = 10; i < 110; ++i) assert(fromArray.TryRead(x) && x == i);
+    assert(fromArray.IsEndOfStream());
+
+    // маленький источник во встроенном буфере, чтение прервано посередине
+    int small[2] = {1, 2};
+    MutableArraySequence<int> inlineArray(small, 2);
+    ReadOnlyStream<int> fromInline(&inlineArray);
+    assert(fromInline.TryRead(x) && x == 1);
+    for (int i = 3; i <= 40; ++i) inlineArray.Append(i);
+    for (int i = 2; i <= 40; ++i) assert(fromInline.TryRead(x) && x == i);
+    assert(!fromInline.TryRead(x));
+
+    // представление: длина окна не меняется, а хранилище под ним переехало
+    int leftItems[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    int rightItems[3] = {8, 9, 10};
+    MutableArraySequence<int> left(leftItems, 8);
+    MutableArraySequence<int> right(rightItems, 3);
+    Sequence<int>* both = left.Concat(right);
+    Sequence<int>* window = both->GetSubsequence(6, 9);
+    ReadOnlyStream<int> fromView(window);
+    assert(fromView.TryRead(x) && x == 6);
+    for (int i = 0; i < 1000; ++i) left.Append(100 + i);
+    // окно по-прежнему с 6 по 9 элемент склейки, а слева их теперь 1008
+    assert(fromView.TryRead(x) && x == 7);
+    assert(fromView.TryRead(x) && x == 100);
+    assert(fromView.TryRead(x) && x == 101);
+    assert(!fromView.TryRead(x));
+    delete window;
+    delete both;
+
+    // список, меняющийся на месте: Append между чтениями не сбивает курсор,
+    // вставка перед позицией — пересоздаёт его
+    MutableUnrolledListSequence<int> unrolled;
+    ReadOnlyStream<int> fromUnrolled(&unrolled);
+    for (int i = 0; i < 5000; ++i) {
+        unrolled.Append(i);
+        assert(fromUnrolled.TryRead(x) && x == i);
+    }
+    assert(!fromUnrolled.TryRead(x));
+    unrolled.Append(5000);
+    unrolled.InsertAt(2500, -1);
+    assert(fromUnrolled.TryRead(x) && x == 4999);
+    assert(fromUnrolled.TryRead(x) && x == 5000);
+    assert(!fromUnrolled.TryRead(x));
+
+    MutableListSequence<int> list;
+    ReadOnlyStream<int> fromList(&list);
+    for (int i = 0; i < 1000; ++i) {
+        assert(list.Append(i) == &list);
+        assert(fromList.TryRead(x) && x == i);
+    }
+    list.Prepend(-1);
+    assert(fromList.TryRead(x) && x == 999);
+    assert(!fromList.TryRead(x));
+    (void)x;
+}
+
+void TestReadOnlyStreamFromListSequence() {
+    int arr[4] = {7, 8, 9, 10};
+    MutableListSequence<int> base(arr, 4);
+
+    ReadOnlyStream<int> stream(&base);
+
+    int x = 0;
+    assert(stream.TryRead(x) && x == 7);
+    assert(stream.TryRead(x) && x == 8);
+
+    // после Seek чтение продолжается с новой позиции
+    stream.Seek(3);
+    assert(stream.TryRead(x) && x == 10);
+    assert(!stream.TryRead(x));
+
+    stream.Seek(1);
+    assert(stream.TryRead(x) && x == 8);
+    (void)x;
+    assert(stream.GetPosition() == 2);
+}
+
+void TestReadOnlyStreamFromUnrolledListSequence() {
+    int arr[3] = {4, 5, 6};
+    MutableUnrolledListSequence<int> base(arr, 3);
+
+    ReadOnlyStream<int> stream(&base);
+
+    int x = 0;
+    stream.Seek(2);
+    assert(stream.TryRead(x) && x == 6);
+    assert(!stream.TryRead(x));
+    (void)x;
+}
+
 void TestReadOnlyStreamFromIStream() {
     std::stringstream ss;
     ss << "10 20 30";
@@ -146,6 +906,432 @@ void TestWriteOnlyStreamToOStream() {
     assert(out == "7 8 9 ");
 }
 
+void TestStreamBlocks() {
+    // вход в несколько сотен КБ: часть чисел разрезана границей буфера
+    std::stringstream ss;
+    const int n = 50000;
+    for (int i = 0; i < n; ++i) ss << (i % 2 ? -i : i) << (i % 7 ? " " : "\n");
+
+    ReadOnlyStream<int> stream(ss, ReadOnlyStream<int>::BlockDeserializer(ParseTextBlock<int>));
+    int block[1000];
+    int expected = 0;
+    std::size_t got;
+    while ((got = stream.ReadBlock(block, 1000)) > 0) {
+        for (std::size_t k = 0; k < got; ++k, ++expected) {
+            assert(block[k] == (expected % 2 ? -expected : expected));
+        }
+    }
+    assert(expected == n && stream.GetPosition() == static_cast<std::size_t>(n));
+    assert(stream.IsEndOfStream());
+
+    // TryRead и ReadBlock делят один буфер; "+5" читается, как и через >>
+    std::stringstream mixed("+5 6 7 8 x 9");
+    ReadOnlyStream<long long> both(mixed, ReadOnlyStream<long long>::BlockDeserializer(ParseTextBlock<long long>));
+    long long v = 0;
+    assert(both.TryRead(v) && v == 5);
+    long long rest[4];
+    assert(both.ReadBlock(rest, 4) == 3 && rest[0] == 6 && rest[2] == 8);
+    (void)rest;
+    assert(both.IsEndOfStream() && !both.TryRead(v));
+    (void)v;
+
+    // обычный Deserializer: ReadBlock — цикл TryRead; источник-последовательность тоже
+    std::stringstream plain("1 2 3");
+    ReadOnlyStream<int> perElement(plain, [](std::istream& in, int& x) { return static_cast<bool>(in >> x); });
+    assert(perElement.ReadBlock(block, 10) == 3 && block[2] == 3);
+    int arr[3] = {4, 5, 6};
+    MutableArraySequence<int> base(arr, 3);
+    ReadOnlyStream<int> fromSeq(&base);
+    assert(fromSeq.ReadBlock(block, 2) == 2 && block[1] == 5);
+    assert(fromSeq.ReadBlock(block, 2) == 1 && block[0] == 6);
+
+    // WriteBlock с блочным сериализатором пишет то же, что поэлементный Write
+    std::ostringstream byElement, byBlock;
+    WriteOnlyStream<double> w1(byElement, [](std::ostream& out, const double& x) { out << x << ' '; });
+    WriteOnlyStream<double> w2(byBlock, WriteOnlyStream<double>::BlockSerializer(FormatTextBlock<double>));
+    double values[4] = {1.5, -2.0, 0.25, 1e6};
+    w1.WriteBlock(values, 4);
+    w2.WriteBlock(values, 3);
+    w2.Write(values[3]);
+    assert(byElement.str() == byBlock.str() && w2.GetPosition() == 4);
+
+    std::stringstream roundTrip(byBlock.str());
+    ReadOnlyStream<double> reader(roundTrip, ReadOnlyStream<double>::BlockDeserializer(ParseTextBlock<double>));
+    double back[8];
+    assert(reader.ReadBlock(back, 8) == 4 && back[1] == -2.0 && back[3] == 1e6);
+    (void)back;
+}
+
+void TestReadOnlyStreamFromMappedFile() {
+    const char* name = "mapped_stream_test.tmp";
+    {
+        std::ofstream out(name, std::ios::binary);
+        for (int i = 0; i < 20000; ++i) out << i * 3 << (i % 10 ? ' ' : '\n');
+    }
+    {
+        MappedFile file(name);
+        ReadOnlyStream<int> stream(file);
+        assert(stream.IsCanSeek());
+
+        int block[777];
+        int expected = 0;
+        std::size_t got;
+        while ((got = stream.ReadBlock(block, 777)) > 0) {
+            for (std::size_t k = 0; k < got; ++k, ++expected) assert(block[k] == expected * 3);
+        }
+        assert(expected == 20000 && stream.IsEndOfStream());
+
+        // переход по номеру элемента и по байтовому смещению
+        stream.Seek(1000);
+        std::size_t offsetOf1000 = stream.GetByteOffset();
+        stream.Seek(12345);
+        int v = 0;
+        assert(stream.TryRead(v) && v == 12345 * 3 && stream.GetPosition() == 12346);
+        stream.SeekByte(offsetOf1000, 1000);
+        assert(stream.TryRead(v) && v == 3000 && stream.GetPosition() == 1001);
+        stream.Seek(50000);
+        assert(stream.GetPosition() == 20000 && !stream.TryRead(v));
+        (void)v;
+
+        // тот же файл сразу в статистику
+        ReadOnlyStream<double> values(file, ReadOnlyStream<double>::BlockDeserializer(ParseTextBlock<double>));
+        OnlineStatistics<double> stats(true, false, true, false);
+        double chunk[4096];
+        while ((got = values.ReadBlock(chunk, 4096)) > 0) stats.AddRange(chunk, got);
+        assert(stats.GetCount() == 20000 && stats.GetMax() == 59997.0);
+        assert(std::fabs(stats.GetMean() - 59997.0 / 2) < 1e-9);
+    }
+    {
+        std::ofstream empty(name, std::ios::trunc);
+    }
+    {
+        MappedFile file(name);
+        assert(file.GetSize() == 0);
+        ReadOnlyStream<int> stream(file);
+        int v = 0;
+        assert(!stream.TryRead(v) && stream.IsEndOfStream());
+        (void)v;
+    }
+    std::remove(name);
+
+    bool failed = false;
+    try { MappedFile missing("no_such_file_for_mapping.txt"); } catch (const std::runtime_error&) { failed = true; }
+    assert(failed);
+    (void)failed;
+}
+
+void TestBinaryStreams() {
+    // 10 полных блоков по 1000 и неполный последний; Write и WriteBlock вперемешку
+    std::stringstream data;
+    const int n = 10500;
+    {
+        BinaryWriteOnlyStream<long long> writer(data, 1000);
+        long long values[n];
+        for (int i = 0; i < n; ++i) values[i] = (i % 2 ? -1LL : 1LL) * i * 1000003LL;
+        writer.Write(values[0]);
+        writer.WriteBlock(values + 1, 2998);
+        writer.Write(values[2999]);
+        writer.WriteBlock(values + 3000, n - 3000);
+        assert(writer.GetPosition() == static_cast<std::size_t>(n));
+    }
+    std::string bytes = data.str();
+    assert(bytes.size() == 24 + n * 8 + 11 * 24);
+
+    {
+        std::stringstream in(bytes);
+        BinaryReadOnlyStream<long long> reader(in);
+        assert(reader.GetCount() == static_cast<std::size_t>(n) && reader.GetBlockSize() == 1000);
+        long long v = 0;
+        assert(reader.TryRead(v) && v == 0);
+        long long block[777];
+        int expected = 1;
+        std::size_t got;
+        while ((got = reader.ReadBlock(block, 777)) > 0) {
+            for (std::size_t k = 0; k < got; ++k, ++expected) {
+                assert(block[k] == (expected % 2 ? -1LL : 1LL) * expected * 1000003LL);
+            }
+        }
+        assert(expected == n && reader.IsEndOfStream() && !reader.TryRead(v));
+        (void)v;
+    }
+
+    // итоги блоков: сумма и экстремумы без чтения значений, блоки можно пропускать
+    {
+        std::stringstream in(bytes);
+        BinaryReadOnlyStream<long long> reader(in);
+        BinaryBlockSummary<long long> summary;
+        long long total = 0, lo = 0, hi = 0;
+        std::size_t blocks = 0, counted = 0;
+        while (reader.PeekBlockSummary(summary)) {
+            assert(reader.PeekBlockSummary(summary));    // повторный Peek не сдвигает позицию
+            total += summary.sum;
+            lo = std::min(lo, summary.min);
+            hi = std::max(hi, summary.max);
+            counted += summary.count;
+            ++blocks;
+            if (blocks == 3) {
+                long long first;
+                assert(reader.TryRead(first) && first == 2000 * 1000003LL);
+                (void)first;
+                bool misaligned = false;
+                try { reader.PeekBlockSummary(summary); } catch (const std::logic_error&) { misaligned = true; }
+                assert(misaligned);
+                (void)misaligned;
+            }
+            reader.SkipBlock();
+        }
+        long long expectedSum = 0;
+        for (int i = 0; i < n; ++i) expectedSum += (i % 2 ? -1LL : 1LL) * i * 1000003LL;
+        assert(blocks == 11 && counted == static_cast<std::size_t>(n) && total == expectedSum);
+        assert(lo == -10499LL * 1000003LL && hi == 10498LL * 1000003LL);
+        assert(reader.IsEndOfStream());
+    }
+
+    // без итогов, через файл; чужой тип и чужие данные отвергаются
+    const char* name = "binary_stream_test.tmp";
+    {
+        BinaryWriteOnlyStream<double> writer(name, 64, false);
+        for (int i = 0; i < 100; ++i) writer.Write(i * 0.5);
+        writer.Close();
+        bool closed = false;
+        try { writer.Write(1.0); } catch (const std::runtime_error&) { closed = true; }
+        assert(closed);
+        (void)closed;
+    }
+    {
+        BinaryReadOnlyStream<double> reader(name);
+        assert(!reader.HasBlockSummaries() && reader.GetCount() == 100);
+        double values[200];
+        assert(reader.ReadBlock(values, 200) == 100 && values[99] == 49.5);
+        (void)values;
+        bool noSummaries = false;
+        BinaryBlockSummary<double> summary;
+        try { reader.PeekBlockSummary(summary); } catch (const std::logic_error&) { noSummaries = true; }
+        assert(noSummaries);
+        (void)noSummaries;
+    }
+    bool wrongType = false;
+    try { BinaryReadOnlyStream<float> reader(name); } catch (const std::runtime_error&) { wrongType = true; }
+    assert(wrongType);
+    (void)wrongType;
+    std::remove(name);
+
+    std::stringstream text("1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24");
+    bool notBinary = false;
+    try { BinaryReadOnlyStream<int> reader(text); } catch (const std::runtime_error&) { notBinary = true; }
+    assert(notBinary);
+    (void)notBinary;
+
+    std::stringstream truncated(bytes.substr(0, 24 + 100));
+    BinaryReadOnlyStream<long long> reader(truncated);
+    long long block[100];
+    bool cut = false;
+    try { reader.ReadBlock(block, 100); } catch (const std::runtime_error&) { cut = true; }
+    assert(cut);
+    (void)cut;
+
+    // пустой поток
+    std::stringstream emptyData;
+    { BinaryWriteOnlyStream<int> writer(emptyData); }
+    BinaryReadOnlyStream<int> empty(emptyData);
+    int v = 0;
+    assert(empty.GetCount() == 0 && empty.IsEndOfStream() && !empty.TryRead(v));
+    (void)v;
+}
+
+void TestAsyncReadOnlyStream() {
+    std::stringstream ss;
+    const int n = 100000;
+    for (int i = 0; i < n; ++i) ss << i << ' ';
+    const std::string text = ss.str();
+
+    // маленькие блоки и короткое кольцо: обе стороны успевают подождать
+    {
+        std::stringstream in(text);
+        ReadOnlyStream<int> source(in, ReadOnlyStream<int>::BlockDeserializer(ParseTextBlock<int>));
+        AsyncReadOnlyStream<int, ReadOnlyStream<int>> async(source, 2, 100);
+        assert(async.GetCapacity() == 2);
+        int v = 0;
+        int expected = 0;
+        for (; expected < 150; ++expected) assert(async.TryRead(v) && v == expected);
+        int block[333];
+        std::size_t got;
+        while ((got = async.ReadBlock(block, 333)) > 0) {
+            for (std::size_t k = 0; k < got; ++k, ++expected) assert(block[k] == expected);
+        }
+        assert(expected == n && async.GetPosition() == static_cast<std::size_t>(n));
+        assert(async.IsEndOfStream() && !async.TryRead(v));
+        (void)v;
+        assert(async.GetQueueDepth() == 0);
+        assert(async.GetConsumerStalls() >= 0 && async.GetProducerStalls() >= 0);
+    }
+
+    // блоки без копирования прямо в статистику; остаток блока после TryRead
+    {
+        std::stringstream in(text);
+        ReadOnlyStream<double> source(in, ReadOnlyStream<double>::BlockDeserializer(ParseTextBlock<double>));
+        using Async = AsyncReadOnlyStream<double, ReadOnlyStream<double>>;
+        Async async(source);
+        OnlineStatistics<double> stats(true, false, true, false);
+        double first = 0;
+        assert(async.TryRead(first) && first == 0);
+        stats.Add(first);
+        const double* data = nullptr;
+        std::size_t count = 0;
+        assert(async.NextBlock(data, count) && count == Async::kDefaultBlockSize - 1 && data[0] == 1);
+        stats.AddRange(data, count);
+        while (async.NextBlock(data, count)) stats.AddRange(data, count);
+        assert(stats.GetCount() == n && stats.GetMax() == n - 1);
+        assert(std::fabs(stats.GetMean() - (n - 1) / 2.0) < 1e-9);
+    }
+
+    // двоичный источник и преждевременное разрушение: фоновый поток не зависает
+    {
+        std::stringstream binary;
+        {
+            BinaryWriteOnlyStream<int> writer(binary, 256);
+            for (int i = 0; i < n; ++i) writer.Write(i);
+        }
+        BinaryReadOnlyStream<int> source(binary);
+        AsyncReadOnlyStream<int, BinaryReadOnlyStream<int>> async(source, 3, 256);
+        int v = 0;
+        for (int i = 0; i < 1000; ++i) assert(async.TryRead(v) && v == i);
+        (void)v;
+    }
+
+    // исключение источника достаётся потребителю после уже прочитанных значений
+    {
+        std::stringstream in(text);
+        ReadOnlyStream<int> source(in, ReadOnlyStream<int>::BlockDeserializer(
+            [](const char*& cursor, const char* end, bool atEnd, int* out, std::size_t max, std::size_t& produced) {
+                if (!ParseTextBlock<int>(cursor, end, atEnd, out, max, produced)) return false;
+                for (std::size_t k = 0; k < produced; ++k) {
+                    if (out[k] == 5000) throw std::runtime_error("bad record");
+                }
+                return true;
+            }));
+        AsyncReadOnlyStream<int, ReadOnlyStream<int>> async(source, 4, 1000);
+        int v = 0;
+        int read = 0;
+        bool failed = false;
+        try {
+            while (async.TryRead(v)) ++read;
+        } catch (const std::runtime_error&) {
+            failed = true;
+        }
+        assert(failed && read == 5000);
+        (void)failed;
+    }
+
+    bool invalid = false;
+    std::stringstream in(text);
+    ReadOnlyStream<int> source(in, ReadOnlyStream<int>::BlockDeserializer(ParseTextBlock<int>));
+    try { AsyncReadOnlyStream<int, ReadOnlyStream<int>> async(source, 1, 100); } catch (const std::invalid_argument&) { invalid = true; }
+    assert(invalid);
+    (void)invalid;
+}
+
+void TestSparseOffsetIndex() {
+    const char* name = "offset_index_test.tmp";
+    const char* sidecar = "offset_index_test.idx";
+    const int n = 100000;    // ~600 КБ: контрольные точки попадают и на стыки буфера
+    {
+        std::ofstream out(name, std::ios::binary);
+        for (int i = 0; i < n; ++i) out << i * 7 << (i % 9 ? " " : "\r\n");
+    }
+    using Stream = ReadOnlyStream<int>;
+    auto parser = Stream::BlockDeserializer(ParseTextBlock<int>);
+
+    // индекс строится первым полным проходом
+    SparseOffsetIndex offsets(1000);
+    {
+        std::ifstream file(name, std::ios::binary);
+        Stream stream(file, parser);
+        assert(!stream.IsCanSeek());
+        stream.AttachIndex(offsets);
+        assert(stream.IsCanSeek());
+        int block[4096];
+        std::size_t got, total = 0;
+        while ((got = stream.ReadBlock(block, 4096)) > 0) total += got;
+        assert(total == static_cast<std::size_t>(n));
+
+        assert(offsets.IsComplete() && offsets.GetRecordCount() == static_cast<std::size_t>(n));
+        assert(offsets.GetCheckpointCount() == n / 1000 + 1);
+        int v = 0;
+        stream.Seek(55555);
+        assert(stream.TryRead(v) && v == 55555 * 7 && stream.GetPosition() == 55556);
+        stream.Seek(10);
+        assert(stream.TryRead(v) && v == 70);
+        stream.Seek(99999);
+        assert(stream.TryRead(v) && v == 99999 * 7 && !stream.TryRead(v) && stream.IsEndOfStream());
+        (void)v;
+        stream.Seek(200000);
+        assert(stream.GetPosition() == static_cast<std::size_t>(n));
+        offsets.Save(sidecar);
+    }
+
+    // сохранённый индекс: переход сразу, без первого прохода
+    {
+        SparseOffsetIndex loaded(sidecar);
+        assert(loaded.IsComplete() && loaded.GetStride() == 1000 && loaded.GetOffset(42) == offsets.GetOffset(42));
+        Stream stream(name, parser);
+        stream.Open();
+        stream.AttachIndex(loaded);
+        int v = 0;
+        stream.Seek(31337);
+        assert(stream.TryRead(v) && v == 31337 * 7);
+
+        MappedFile file(name);
+        Stream mappedStream(file);
+        mappedStream.AttachIndex(loaded);
+        mappedStream.Seek(77777);
+        assert(mappedStream.TryRead(v) && v == 77777 * 7);
+        (void)v;
+    }
+
+    // неполный индекс достраивается при переходе вперёд
+    {
+        SparseOffsetIndex partial(500);
+        std::ifstream file(name, std::ios::binary);
+        Stream stream(file, parser);
+        stream.AttachIndex(partial);
+        int v = 0;
+        stream.Seek(7777);
+        assert(stream.TryRead(v) && v == 7777 * 7);
+        assert(!partial.IsComplete() && partial.GetCheckpointCount() == 7777 / 500 + 1);
+        assert(partial.GetOffset(10) == offsets.GetOffset(5));
+        stream.Seek(3);
+        assert(stream.TryRead(v) && v == 21);
+        (void)v;
+        bool incomplete = false;
+        try { partial.Save(sidecar); } catch (const std::logic_error&) { incomplete = true; }
+        assert(incomplete);
+        (void)incomplete;
+    }
+
+    // индекс другого файла и подключение после чтения отвергаются
+    {
+        std::stringstream other("1 2 3");
+        Stream stream(other, parser);
+        bool stale = false;
+        try { stream.AttachIndex(offsets); } catch (const std::runtime_error&) { stale = true; }
+        assert(stale);
+        (void)stale;
+
+        std::stringstream late("1 2 3");
+        Stream started(late, parser);
+        int v = 0;
+        started.TryRead(v);
+        SparseOffsetIndex fresh(10);
+        bool tooLate = false;
+        try { started.AttachIndex(fresh); } catch (const std::logic_error&) { tooLate = true; }
+        assert(tooLate);
+        (void)tooLate;
+    }
+    std::remove(name);
+    std::remove(sidecar);
+}
+
 // --------------- OnlineStatistics tests ---------------
 
 void TestOnlineStatisticsBasic() {
@@ -187,21 +1373,218 @@ void TestOnlineStatisticsBasic() {
     for (int i = 0; i < 5; ++i) statsOdd.Add(vals[i]);
     double medOdd = statsOdd.GetMedian();
     assert(std::fabs(medOdd - 3.0) < 1e-9);
+
+    // AddRange по блокам даёт те же результаты, что Add по одному
+    OnlineStatistics<double> single(true, true, true, true);
+    OnlineStatistics<double> ranged(true, true, true, true);
+    double data[1000];
+    for (int i = 0; i < 1000; ++i) {
+        data[i] = 1e6 + std::sin(i * 0.1) * (i % 13);
+        single.Add(data[i]);
+    }
+    ranged.AddRange(data, 1);
+    ranged.AddRange(data + 1, 0);
+    ranged.AddRange(data + 1, 600);
+    ranged.AddRange(data + 601, 399);
+    assert(ranged.GetCount() == 1000);
+    assert(std::fabs(ranged.GetMean() - single.GetMean()) < 1e-9);
+    assert(std::fabs(ranged.GetVariance() - single.GetVariance()) < 1e-9 * single.GetVariance());
+    assert(ranged.GetMin() == single.GetMin() && ranged.GetMax() == single.GetMax());
+    assert(ranged.GetMedian() == single.GetMedian());
+}
+
+void TestOnlineStatisticsMerge() {
+    // части разного размера, в том числе пустые, дают то же, что один проход
+    OnlineStatistics<double> whole(true, true, true, true);
+    OnlineStatistics<double> merged(true, true, true, true);
+    const int sizes[5] = {0, 1, 257, 1000, 3};
+    double value = 0;
+    for (int part = 0; part < 5; ++part) {
+        OnlineStatistics<double> piece(true, true, true, true);
+        for (int i = 0; i < sizes[part]; ++i) {
+            value = 1e9 + std::cos(value + i) * 1000;
+            whole.Add(value);
+            piece.Add(value);
+        }
+        merged.Merge(piece);
+    }
+    assert(merged.GetCount() == whole.GetCount());
+    assert(std::fabs(merged.GetMean() - whole.GetMean()) < 1e-6);
+    assert(std::fabs(merged.GetVariance() - whole.GetVariance()) < 1e-9 * whole.GetVariance());
+    assert(merged.GetMin() == whole.GetMin() && merged.GetMax() == whole.GetMax());
+    assert(merged.GetMedian() == whole.GetMedian());
+
+    OnlineStatistics<double> other(true, false, true, false);
+    bool differ = false;
+    try { merged.Merge(other); } catch (const std::invalid_argument&) { differ = true; }
+    assert(differ);
+    (void)differ;
+}
+
+void TestIngestPartitioned() {
+    const char* name = "partitioned_ingest_test.tmp";
+    const int n = 200000;
+    auto write = [&](int badAt) {
+        std::ofstream out(name, std::ios::binary);
+        for (int i = 0; i < n; ++i) {
+            if (i == badAt) out << "oops ";
+            out << (i % 1000) * 0.25 - 17 << (i % 11 ? " " : "\n");
+        }
+    };
+    auto serial = [&](OnlineStatistics<double>& stats) {
+        MappedFile file(name);
+        ReadOnlyStream<double> stream(file);
+        double block[4096];
+        std::size_t got;
+        while ((got = stream.ReadBlock(block, 4096)) > 0) stats.AddRange(block, got);
+    };
+
+    write(-1);
+    {
+        MappedFile file(name);
+        // границы всегда между числами
+        DynamicArray<std::size_t> bounds = SplitOnDelimiters(file.Data(), file.GetSize(), 13);
+        for (int i = 1; i < 13; ++i) {
+            std::size_t b = bounds[i];
+            assert(b >= bounds[i - 1]);
+            assert(b == file.GetSize() || IsTextSpace(file.Data()[b]) || IsTextSpace(file.Data()[b - 1]));
+            (void)b;
+        }
+
+        OnlineStatistics<double> expected(true, true, true, true);
+        serial(expected);
+        for (int threads : {1, 3, 8}) {
+            OnlineStatistics<double> stats(true, true, true, true);
+            IngestPartitioned(file, stats, threads, 1000);
+            assert(stats.GetCount() == n);
+            assert(std::fabs(stats.GetMean() - expected.GetMean()) < 1e-9);
+            assert(std::fabs(stats.GetVariance() - expected.GetVariance()) < 1e-9 * expected.GetVariance());
+            assert(stats.GetMin() == -17 && stats.GetMax() == 999 * 0.25 - 17);
+            assert(stats.GetMedian() == expected.GetMedian());
+        }
+    }
+
+    // не-числовая лексема посреди файла: учитывается то же, что при чтении потоком
+    write(123456);
+    {
+        MappedFile file(name);
+        OnlineStatistics<double> expected(true, false, false, false);
+        serial(expected);
+        assert(expected.GetCount() == 123456);
+        OnlineStatistics<double> stats(true, false, false, false);
+        IngestPartitioned(file, stats, 6, 1000);
+        assert(stats.GetCount() == 123456 && stats.GetMean() == expected.GetMean());
+    }
+
+    {
+        std::ofstream empty(name, std::ios::trunc);
+    }
+    {
+        MappedFile file(name);
+        OnlineStatistics<double> stats(true, true, true, true);
+        IngestPartitioned(file, stats, 4, 1);
+        assert(stats.GetCount() == 0);
+    }
+    std::remove(name);
+}
+
+// --------------- AllocScope tests ---------------
+// Счётчики ненулевые только при сборке с ALLOC_TRACKING; без него проверяем,
+// что AllocScope просто компилируется и возвращает нули. Сырые блоки берём
+// через ::operator new: пару new/delete-выражений компилятор вправе выбросить.
+
+void TestAllocScope() {
+    if constexpr (!AllocTrackingEnabled()) {
+        AllocScope scope;
+        int* p = new int(1);
+        delete p;
+        assert(scope.Allocations() == 0 && scope.PeakBytes() == 0);
+        return;
+    }
+
+    {
+        AllocScope scope;
+        void* p = ::operator new(256 * sizeof(int));
+        assert(scope.Allocations() == 1 && scope.Bytes() == 256 * sizeof(int));
+        ::operator delete(p);
+        assert(scope.Deallocations() == 1 && scope.PeakBytes() >= static_cast<std::int64_t>(256 * sizeof(int)));
+    }
+
+    // короткая строка и пара узлов списка живут во встроенных буферах
+    {
+        AllocScope scope;
+        MutableArraySequence<char> row;
+        for (int i = 0; i < 16; i++) row.Append('.');
+        LinkedList<int> neighbours;
+        neighbours.Append(1);
+        neighbours.Append(2);
+        assert(scope.Allocations() == 0);
+        row.Append('x');
+        assert(scope.Allocations() == 1);
+    }
+
+    // вложенная область не теряет пик внешней
+    {
+        AllocScope outer;
+        ::operator delete(::operator new(1 << 16));
+        {
+            AllocScope inner;
+            ::operator delete(::operator new(16));
+            assert(inner.PeakBytes() >= 16 && inner.PeakBytes() < (1 << 16));
+        }
+        assert(outer.PeakBytes() >= (1 << 16));
+    }
 }
 
 inline void RunAllNewTests() {
+    std::cout << "Running AllocScope tests...\n";
+    TestAllocScope();
+    std::cout << "AllocScope tests OK" << (AllocTrackingEnabled() ? "" : " (tracking disabled)") << "\n";
+
+    std::cout << "Running UnrolledList tests...\n";
+    TestUnrolledListSequence();
+    std::cout << "UnrolledList tests OK\n";
+
+    std::cout << "Running Sequence views tests...\n";
+    TestSequenceViews();
+    std::cout << "Sequence views tests OK\n";
+
+    std::cout << "Running ImmutableArraySequence tests...\n";
+    TestPersistentImmutableArraySequence();
+    std::cout << "ImmutableArraySequence tests OK\n";
+
     std::cout << "Running LazySequence tests...\n";
     TestLazySequenceBasic();
+    TestLazySequenceBatch();
+    TestBlockCache();
+    TestLazySequenceRandomAccess();
+    TestLazySequenceUnbounded();
+    TestLazySequenceParallel();
+    TestLazySequenceConcurrentReaders();
     std::cout << "LazySequence tests OK\n";
 
+    std::cout << "Running LazyPipeline tests...\n";
+    TestLazyPipeline();
+    std::cout << "LazyPipeline tests OK\n";
+
     std::cout << "Running Streams tests...\n";
     TestReadOnlyStreamFromSequence();
+    TestReadOnlyStreamFromGrowingSequence();
+    TestReadOnlyStreamFromListSequence();
+    TestReadOnlyStreamFromUnrolledListSequence();
     TestReadOnlyStreamFromIStream();
     TestWriteOnlyStreamToOStream();
+    TestStreamBlocks();
+    TestReadOnlyStreamFromMappedFile();
+    TestBinaryStreams();
+    TestAsyncReadOnlyStream();
+    TestSparseOffsetIndex();
     std::cout << "Streams tests OK\n";
 
     std::cout << "Running OnlineStatistics tests...\n";
     TestOnlineStatisticsBasic();
+    TestOnlineStatisticsMerge();
+    TestIngestPartitioned();
     std::cout << "OnlineStatistics tests OK\n";
 
     std::cout << "All new tests passed successfully.\n";
@@ -8,6 +8,7 @@
 #include "LazySequence.h"
 #include "Streams.h"
 #include "OnlineStatistics.h"
+#include "PartitionedIngest.h"
 #include "TestsStatistics.h"
 #include "PerformanceTests.h"
 
@@ -70,26 +71,30 @@ void RunStatisticsDemo() {
         // Adjust this path according to your build setup
         std::string fullPath = "../Semester_3_Lab_1/files/" + fileName;
 
-        auto deserializer = [](std::istream& in, double& value) -> bool {
-            return static_cast<bool>(in >> value);
-        };
-
-        std::ifstream fin(fullPath);
-        if (!fin.is_open()) {
-            std::cerr << "Error opening file: " << fullPath << "\n";
-            return;
-        }
-
         try {
-            ReadOnlyStream<double> stream(fin, deserializer);
-            long long processed = 0;
-            double x;
-            while ((limit <= 0 || processed < limit) && stream.TryRead(x)) {
-                stats.Add(x);
-                ++processed;
+            // файл отображается в память и разбирается прямо из страниц
+            MappedFile file(fullPath);
+            if (limit <= 0) {
+                // весь файл: части разбираются параллельно и сливаются
+                IngestPartitioned(file, stats);
+            } else {
+                ReadOnlyStream<double> stream(file);
+                const std::size_t blockSize = 4096;
+                DynamicArray<double> block(static_cast<int>(blockSize));
+                long long processed = 0;
+                while (processed < limit) {
+                    std::size_t want = blockSize;
+                    if (static_cast<long long>(want) > limit - processed) {
+                        want = static_cast<std::size_t>(limit - processed);
+                    }
+                    std::size_t got = stream.ReadBlock(block.begin(), want);
+                    stats.AddRange(block.begin(), got);
+                    processed += static_cast<long long>(got);
+                    if (got < want) break;
+                }
             }
         } catch (const std::exception& ex) {
-            std::cerr << "Error while reading stream: " << ex.what() << "\n";
+            std::cerr << "Error while reading " << fullPath << ": " << ex.what() << "\n";
             return;
         }
     } else {
@@ -33,52 +33,28 @@ Board::Board()
 
 // --- РАСШИРЕНИЯ ---
 
+// Строки меняются на месте через ссылки grid[r] — без копирования всей сетки.
+
 void Board::expandLeft() {
-    int newW = width + 1;
-    for (int r = 0; r < height; ++r) {
-        MutableArraySequence<char> oldRow = grid.Get(r);
-        char* buf = new char[newW];
-        buf[0] = '.';
-        for (int c = 0; c < width; ++c) buf[c + 1] = oldRow.Get(c);
-        grid.Set(r, MutableArraySequence<char>(buf, newW));
-        delete[] buf;
-    }
-    width = newW;
+    for (int r = 0; r < height; ++r) grid[r].Prepend('.');
+    width += 1;
     offsetX += 1;
 }
 
 void Board::expandRight() {
-    int newW = width + 1;
-    for (int r = 0; r < height; ++r) {
-        MutableArraySequence<char> oldRow = grid.Get(r);
-        char* buf = new char[newW];
-        for (int c = 0; c < width; ++c) buf[c] = oldRow.Get(c);
-        buf[newW - 1] = '.';
-        grid.Set(r, MutableArraySequence<char>(buf, newW));
-        delete[] buf;
-    }
-    width = newW;
+    for (int r = 0; r < height; ++r) grid[r].Append('.');
+    width += 1;
 }
 
 void Board::expandUp() {
-    int newH = height + 1;
-    auto* rows = new MutableArraySequence<char>[newH];
-    rows[0] = makeRow(width, '.'); // новая верхняя строка
-    for (int r = 0; r < height; ++r) rows[r + 1] = grid.Get(r);
-    grid = MutableArraySequence<MutableArraySequence<char>>(rows, newH);
-    delete[] rows;
-    height = newH;
+    grid.Prepend(makeRow(width, '.')); // новая верхняя строка
+    height += 1;
     offsetY += 1;
 }
 
 void Board::expandDown() {
-    int newH = height + 1;
-    auto* rows = new MutableArraySequence<char>[newH];
-    for (int r = 0; r < height; ++r) rows[r] = grid.Get(r);
-    rows[newH - 1] = makeRow(width, '.'); // новая нижняя строка
-    grid = MutableArraySequence<MutableArraySequence<char>>(rows, newH);
-    delete[] rows;
-    height = newH;
+    grid.Append(makeRow(width, '.')); // новая нижняя строка
+    height += 1;
 }
 
 void Board::ensureContains(int x, int y) {
@@ -93,16 +69,17 @@ void Board::ensureContains(int x, int y) {
 
 // --- ОСНОВНЫЕ МЕТОДЫ ---
 
+// toIndex уже проверил границы окна — дальше доступ без повторных проверок.
 bool Board::IsCellEmpty(int x, int y) const {
     int r, c;
     if (!toIndex(x, y, r, c)) return true; // вне окна считаем пустым
-    return grid.Get(r).Get(c) == '.';
+    return grid[r][c] == '.';
 }
 
 char Board::GetCell(int x, int y) const {
     int r, c;
     if (!toIndex(x, y, r, c)) return '.';
-    return grid.Get(r).Get(c);
+    return grid[r][c];
 }
 
 void Board::PlaceMove(int x, int y, char symbol) {
@@ -113,9 +90,7 @@ void Board::PlaceMove(int x, int y, char symbol) {
     int r = y + offsetY;
     int c = x + offsetX;
 
-    auto row = grid.Get(r);
-    row.Set(c, symbol);
-    grid.Set(r, row);
+    grid[r][c] = symbol;
 
     if (minX > maxX) {
         minX = maxX = x;
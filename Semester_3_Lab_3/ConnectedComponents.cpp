@@ -9,8 +9,7 @@ namespace cc {
         comp.push_back(v);
         LinkedList<int> neigh;
         g.GetNeighbors(v, neigh);
-        for (int i = 0; i < neigh.GetLength(); ++i) {
-            int u = neigh.Get(i);
+        for (int u : neigh) {
             if (!used[u]) dfsOne(g, u, used, comp);
         }
     }
@@ -38,8 +37,7 @@ namespace cc {
             comp.push_back(v);
             LinkedList<int> neigh;
             g.GetNeighbors(v, neigh);
-            for (int i = 0; i < neigh.GetLength(); ++i) {
-                int u = neigh.Get(i);
+            for (int u : neigh) {
                 if (!used[u]) { used[u] = true; q.push(u); }
             }
         }
@@ -49,8 +49,7 @@ static inline long long edgeKey(int u, int v) {
 // ---------- helper: получить отсортированный список соседей вершины ----------
 static std::vector<int> NeighSorted(const AdjListGraph& g, int u) {
     LinkedList<int> L; g.GetNeighbors(u, L);
-    std::vector<int> v; v.reserve(L.GetLength());
-    for (int i = 0; i < L.GetLength(); ++i) v.push_back(L.Get(i));
+    std::vector<int> v(L.begin(), L.end());
     std::sort(v.begin(), v.end());
     return v;
 }
@@ -166,8 +165,7 @@ static void VisualizeImpl(const AdjListGraph& g, int initialOverlay, bool showEd
     edges.reserve(n * 2);
     for (int u = 0; u < n; ++u) {
         LinkedList<int> neigh; g.GetNeighbors(u, neigh);
-        for (int i = 0; i < neigh.GetLength(); ++i) {
-            int v = neigh.Get(i);
+        for (int v : neigh) {
             if (v > u) edges.emplace_back(u, v);
         }
     }
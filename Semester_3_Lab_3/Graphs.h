@@ -3,23 +3,26 @@
 #include <stdexcept>
 #include "dynamic_array.h"
 #include "Lists.h"
+#include "UnrolledList.h"
 #include "IGraph.h"
 
 // --- Неориентированный граф на списках смежности ---
-class AdjListGraph : public IGraph {
+// AdjList — контейнер соседей одной вершины: LinkedList<int> (узлы в NodePool),
+// LinkedList<int, HeapNodeAllocator> или UnrolledList<int>. Нужны Append и обход.
+template<typename AdjList = LinkedList<int>>
+class BasicAdjListGraph : public IGraph {
     int n;
-    DynamicArray<LinkedList<int>> adj;
+    DynamicArray<AdjList> adj;
 
     // проверка: есть ли уже ребро u--v
     bool hasNeighbor(int u, int v) const {
-        const LinkedList<int>& lu = adj[u];
-        for (int i = 0; i < lu.GetLength(); ++i)
-            if (lu.Get(i) == v) return true;
+        for (int w : adj[u])
+            if (w == v) return true;
         return false;
     }
 
 public:
-    explicit AdjListGraph(int vertices) : n(vertices), adj(vertices) {}
+    explicit BasicAdjListGraph(int vertices) : n(vertices), adj(vertices) {}
 
     int VerticesCount() const override { return n; }
 
@@ -40,12 +43,13 @@ public:
     // Выдать соседей v в outNeighbors; ожидаем, что outNeighbors пуст
     void GetNeighbors(int v, LinkedList<int>& outNeighbors) const override {
         if (v < 0 || v >= n) throw std::out_of_range("vertex index");
-        const LinkedList<int>& src = adj[v];
-        for (int i = 0; i < src.GetLength(); ++i)
-            outNeighbors.Append(src.Get(i));
+        for (int w : adj[v])
+            outNeighbors.Append(w);
     }
 };
 
+using AdjListGraph = BasicAdjListGraph<>;
+
 // --- Ленивый граф (материализация по требованию) ---
 // N вершин (0..N-1). Соседи v: (v-2) и (v+2), если в пределах.
 class OnDemandGraph : public IGraph {
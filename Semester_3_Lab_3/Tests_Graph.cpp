@@ -91,5 +91,69 @@ extern "C" void RunGraphTests() {
         assert((int)a[0].size() == N);
     }
 
+    { // T8: списки на пуле узлов — рост через несколько блоков, перемещение, копия
+        LinkedList<int> L;
+        for (int i = 0; i < 100; ++i) L.Append(i);
+        L.Prepend(-1);
+        L.InsertAt(50, 1000);
+        assert(L.GetLength() == 102 && L.GetFirst() == -1 && L.Get(50) == 1000 && L.GetLast() == 99);
+
+        LinkedList<int> moved(std::move(L));
+        assert(moved.GetLength() == 102 && L.GetLength() == 0);
+        L.Append(7); // пул после перемещения снова пригоден
+        assert(L.GetLength() == 1 && L.GetFirst() == 7);
+
+        LinkedList<int> copy(moved);
+        moved = LinkedList<int>();
+        long long sum = 0;
+        for (int v : copy) sum += v;
+        assert(sum == 4950 - 1 + 1000);
+        std::cout << "T8 pooled list: PASS\n";
+    }
+
+    { // T9: другие контейнеры соседей дают те же компоненты
+        BasicAdjListGraph<LinkedList<int, HeapNodeAllocator>> h(5);
+        h.AddEdge(0,1); h.AddEdge(1,2);
+        h.AddEdge(3,4);
+        auto a = cc::ConnectedComponentsBFS(h);
+        expectCount("T9 heap-node graph (BFS)", (int)a.size(), 2);
+
+        BasicAdjListGraph<UnrolledList<int>> u(40);
+        for (int v = 1; v < 40; ++v) u.AddEdge(0, v); // звезда: соседи 0 занимают несколько узлов
+        auto b = cc::ConnectedComponentsDFS(u);
+        expectCount("T9 unrolled graph (DFS)", (int)b.size(), 1);
+        assert((int)b[0].size() == 40);
+    }
+
+    { // T10: встроенные узлы пула переживают перемещение списка
+        LinkedList<int> small;
+        small.Append(1); small.Append(2);          // обе ячейки встроенного буфера
+        LinkedList<int> movedSmall(std::move(small));
+        small.Append(3);
+        assert(movedSmall.GetLength() == 2 && movedSmall.GetFirst() == 1 && movedSmall.GetLast() == 2);
+        assert(small.GetLength() == 1 && small.GetFirst() == 3);
+
+        LinkedList<int> mixed;
+        mixed.Append(10); mixed.Append(20);         // встроенные
+        for (int i = 0; i < 5; ++i) mixed.Prepend(i); // из кучи, встают перед встроенными
+        mixed = LinkedList<int>(std::move(mixed));
+        int expected[] = {4, 3, 2, 1, 0, 10, 20};
+        int k = 0;
+        for (int v : mixed) assert(v == expected[k++]);
+        assert(k == 7 && mixed.GetLast() == 20);
+        mixed.Append(30);
+        assert(mixed.GetLast() == 30 && mixed.Get(6) == 20);
+
+        // перенос при росте DynamicArray тоже идёт через перемещение списков
+        DynamicArray<LinkedList<int>> lists(0);
+        for (int v = 0; v < 20; ++v) {
+            lists.PushBack(LinkedList<int>());
+            lists[v].Append(v); lists[v].Append(-v);
+        }
+        for (int v = 0; v < 20; ++v)
+            assert(lists[v].GetFirst() == v && lists[v].GetLast() == -v && lists[v].GetLength() == 2);
+        std::cout << "T10 inline list nodes: PASS\n";
+    }
+
     std::cout << "All graph tests passed.\n";
 }
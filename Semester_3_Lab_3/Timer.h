@@ -1,11 +1,21 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
+#include "AllocTracking.h"
+#include "ProcessMemory.h"
 
+// Заодно считает выделения памяти с момента start() — ненулевые только
+// в сборке с учётом выделений (ALLOC_TRACKING, см. AllocTracking.h).
 struct Timer {
     using clock = std::chrono::high_resolution_clock;
     clock::time_point t0;
-    void start() { t0 = clock::now(); }
+    std::uint64_t allocs0 = 0;
+    void start() {
+        allocs0 = CurrentAllocCounters().allocations;
+        t0 = clock::now();
+    }
     long long ms() const {
         return std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - t0).count();
     }
+    std::uint64_t allocations() const { return CurrentAllocCounters().allocations - allocs0; }
 };
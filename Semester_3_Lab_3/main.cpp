@@ -7,6 +7,9 @@
 #include <string>
 #include <queue>
 #include <filesystem>
+#include <memory>
+#include <random>
+#include <cstdlib>
 
 #include "Timer.h"
 #include "Graphs.h"
@@ -28,8 +31,7 @@ static void SaveEdgesCSV(const AdjListGraph& g, const std::filesystem::path& fil
     const int n = g.VerticesCount();
     for (int u = 0; u < n; ++u) {
         LinkedList<int> L; g.GetNeighbors(u, L);
-        for (int i = 0; i < L.GetLength(); ++i) {
-            int v = L.Get(i);
+        for (int v : L) {
             if (v > u) out << u << "," << v << "\n"; // только u<v, без дублей
         }
     }
@@ -87,24 +89,30 @@ static void runManual() {
         Timer t; t.start();
         auto comps = cc::ConnectedComponentsDFS(g);
         long long ms = t.ms();
+        std::uint64_t allocs = t.allocations();
         std::cout << "Components: " << comps.size() << "\n";
         for (size_t i = 0; i < comps.size(); ++i) {
             std::cout << "Component " << (i+1) << ": ";
             for (int v : comps[i]) std::cout << v << " ";
             std::cout << "\n";
         }
-        std::cout << "Time (DFS): " << ms << " ms\n";
+        std::cout << "Time (DFS): " << ms << " ms";
+        if (AllocTrackingEnabled()) std::cout << ", allocations: " << allocs;
+        std::cout << "\n";
     } else if (choice == 2) {
         Timer t; t.start();
         auto comps = cc::ConnectedComponentsBFS(g);
         long long ms = t.ms();
+        std::uint64_t allocs = t.allocations();
         std::cout << "Components: " << comps.size() << "\n";
         for (size_t i = 0; i < comps.size(); ++i) {
             std::cout << "Component " << (i+1) << ": ";
             for (int v : comps[i]) std::cout << v << " ";
             std::cout << "\n";
         }
-        std::cout << "Time (BFS): " << ms << " ms\n";
+        std::cout << "Time (BFS): " << ms << " ms";
+        if (AllocTrackingEnabled()) std::cout << ", allocations: " << allocs;
+        std::cout << "\n";
     } else {
         // сравнение времени и сохранение только times в graphs_csv
         Timer t1; t1.start(); auto a = cc::ConnectedComponentsDFS(g); long long ms1 = t1.ms();
@@ -140,11 +148,81 @@ static void runExportEdgesOnly() {
     std::cout << "Saved edges CSV: " << std::filesystem::absolute(path) << "\n";
 }
 
+// ---------------------- бенчмарк построения графа ----------------------
+// E случайных рёбер на V вершинах (фиксированный seed), замеры: время AddEdge,
+// прирост RSS и время разрушения графа.
+template<typename AdjList>
+static void benchGraphBuild(const char* name, int vertices, int edges) {
+    long long rss0 = CurrentRssKB();
+    AllocScope allocs;
+    Timer t; t.start();
+    auto g = std::make_unique<BasicAdjListGraph<AdjList>>(vertices);
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> pick(0, vertices - 1);
+    int added = 0;
+    while (added < edges) {
+        int u = pick(rng), v = pick(rng);
+        if (u == v) continue;
+        try {
+            g->AddEdge(u, v);
+            ++added;
+        } catch (const std::logic_error&) {
+            // повторное ребро — берём другую пару
+        }
+    }
+    long long buildMs = t.ms();
+    std::uint64_t buildAllocs = t.allocations();
+    std::int64_t peakBytes = allocs.PeakBytes();
+    long long rss1 = CurrentRssKB();
+
+    Timer td; td.start();
+    g.reset();
+    long long destroyMs = td.ms();
+
+    std::cout << name << ": V=" << vertices << " E=" << edges
+              << " build " << buildMs << " ms, RSS +" << (rss1 - rss0) << " KB"
+              << ", destroy " << destroyMs << " ms";
+    if (AllocTrackingEnabled())
+        std::cout << ", allocations " << buildAllocs << ", heap peak +" << peakBytes / 1024 << " KB";
+    std::cout << "\n";
+}
+
+// --bench-graph [heap|pool|unrolled|all] [V] [E]
+// Для "all" каждый вариант запускается отдельным процессом, чтобы RSS
+// второго не искажала память, оставшаяся в куче после первого.
+static int runGraphBenchmark(int argc, char** argv) {
+    std::string variant = argc > 2 ? argv[2] : "all";
+    int vertices = argc > 3 ? std::atoi(argv[3]) : 200000;
+    int edges = argc > 4 ? std::atoi(argv[4]) : 1000000;
+    if (vertices < 2 || edges < 0 || 1LL * vertices * (vertices - 1) / 2 < edges) {
+        std::cout << "Error: need V >= 2 and 0 <= E <= V*(V-1)/2\n";
+        return 1;
+    }
+
+    if (variant == "heap") benchGraphBuild<LinkedList<int, HeapNodeAllocator>>("heap", vertices, edges);
+    else if (variant == "pool") benchGraphBuild<LinkedList<int>>("pool", vertices, edges);
+    else if (variant == "unrolled") benchGraphBuild<UnrolledList<int>>("unrolled", vertices, edges);
+    else if (variant == "all") {
+        for (const char* v : {"heap", "pool", "unrolled"}) {
+            std::string cmd = std::string("\"") + argv[0] + "\" --bench-graph " + v + " "
+                            + std::to_string(vertices) + " " + std::to_string(edges);
+            if (std::system(cmd.c_str()) != 0) return 1;
+        }
+    } else {
+        std::cout << "Unknown variant: " << variant << " (expected heap, pool, unrolled or all)\n";
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char** argv) {
     if (argc > 1 && (std::strcmp(argv[1], "--test") == 0)) {
         RunGraphTests();
         return 0;
     }
+    if (argc > 1 && (std::strcmp(argv[1], "--bench-graph") == 0)) {
+        return runGraphBenchmark(argc, argv);
+    }
 
     std::cout << "Lab3: Undirected Graph + Connected Components + Lazy Graph\n";
     for (;;) {
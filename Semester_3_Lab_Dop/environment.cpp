@@ -60,9 +60,10 @@ const Sequence<Value>* Environment::GetSample(const std::string& sampleName) con
  *
  * Если выборка не существует, она создаётся автоматически.
  *
- * Важно: метод Append у Sequence<Value> не изменяет текущий объект,
- * а возвращает новый экземпляр последовательности.
- * Поэтому старая последовательность заменяется новой.
+ * MutableArraySequence::Append добавляет элемент на месте
+ * (амортизированно O(1)) и возвращает тот же объект.
+ * Неизменяемые реализации Sequence<Value> возвращают новый экземпляр —
+ * тогда старая последовательность заменяется новой.
  */
 void Environment::CollectSample(const std::string& sampleName, const Value& value) {
     // Найти или создать выборку
@@ -75,9 +76,10 @@ void Environment::CollectSample(const std::string& sampleName, const Value& valu
     // Текущая последовательность
     Sequence<Value>* seq = it->second.get();
 
-    // Добавление элемента создаёт новую последовательность
     Sequence<Value>* newSeq = seq->Append(value);
 
-    // Заменяем старую последовательность на новую
-    it->second.reset(newSeq);
+    // Заменяем последовательность, только если Append вернул новый объект
+    if (newSeq != seq) {
+        it->second.reset(newSeq);
+    }
 }
\ No newline at end of file
@@ -1,5 +1,28 @@
 #include "statlib.h"
 
+#include <span>
+
+/*
+ * Обход числовых значений выборки.
+ *
+ * Если реализация Sequence хранит элементы подряд (ArraySequence),
+ * цикл идёт прямо по буферу — без виртуальных вызовов и копий.
+ * Иначе — один линейный проход через ForEach.
+ */
+template<typename Fn>
+static void ForEachNumber(const Sequence<Value>& seq, Fn&& fn) {
+    std::span<const Value> values;
+    if (seq.TryGetContiguous(values)) {
+        for (const Value& v : values) {
+            fn(v.AsNumber());
+        }
+        return;
+    }
+    seq.ForEach([&](const Value& v) {
+        fn(v.AsNumber());
+    });
+}
+
 /*
  * Возвращает количество элементов в выборке.
  *
@@ -22,10 +45,9 @@ double Statistics::Moment(const Sequence<Value>& seq, std::size_t k) {
     }
 
     double sum = 0.0;
-    for (std::size_t i = 0; i < n; ++i) {
-        double x = seq.Get(i).AsNumber();
+    ForEachNumber(seq, [&](double x) {
         sum += std::pow(x, static_cast<double>(k));
-    }
+    });
 
     return sum / static_cast<double>(n);
 }
@@ -43,11 +65,10 @@ double Statistics::CentralMoment(const Sequence<Value>& seq, std::size_t k) {
     double mean = Moment(seq, 1);
     double sum = 0.0;
 
-    for (std::size_t i = 0; i < n; ++i) {
-        double x = seq.Get(i).AsNumber();
+    ForEachNumber(seq, [&](double x) {
         double d = x - mean;
         sum += std::pow(d, static_cast<double>(k));
-    }
+    });
 
     return sum / static_cast<double>(n);
 }
@@ -91,6 +112,7 @@ double Statistics::StdDev(const Sequence<Value>& seq) {
  *
  * Алгоритм:
  *  1. Копирование значений из Sequence в std::vector<double>
+ *     (напрямую из буфера, если выборка хранится непрерывно)
  *  2. Сортировка
  *  3. Выбор центрального элемента:
  *     - при нечётном размере — средний элемент
@@ -105,9 +127,9 @@ double Statistics::Median(const Sequence<Value>& seq) {
     std::vector<double> data;
     data.reserve(n);
 
-    for (std::size_t i = 0; i < n; ++i) {
-        data.push_back(seq.Get(i).AsNumber());
-    }
+    ForEachNumber(seq, [&](double x) {
+        data.push_back(x);
+    });
 
     std::sort(data.begin(), data.end());
 
@@ -138,9 +160,20 @@ double Statistics::Covariance(const Sequence<Value>& x, const Sequence<Value>& y
     double meanY = Mean(y);
 
     double sum = 0.0;
-    for (std::size_t i = 0; i < nx; ++i) {
-        double xi = x.Get(i).AsNumber();
-        double yi = y.Get(i).AsNumber();
+
+    std::span<const Value> xs, ys;
+    if (x.TryGetContiguous(xs) && y.TryGetContiguous(ys)) {
+        for (std::size_t i = 0; i < nx; ++i) {
+            sum += (xs[i].AsNumber() - meanX) * (ys[i].AsNumber() - meanY);
+        }
+        return sum / static_cast<double>(nx);
+    }
+
+    // Иначе две выборки обходятся синхронно итераторами (по O(1) на шаг)
+    auto itY = y.begin();
+    for (auto itX = x.begin(); itX != x.end(); ++itX, ++itY) {
+        double xi = (*itX).AsNumber();
+        double yi = (*itY).AsNumber();
         sum += (xi - meanX) * (yi - meanY);
     }
 
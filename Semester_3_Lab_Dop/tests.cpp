@@ -13,6 +13,7 @@
 #include "environment.h"
 #include "statlib.h"
 #include "interpreter.h"
+#include "Lists.h"
 #include <limits>
 
 // ========================= Тесты для Value =========================
@@ -445,6 +446,14 @@ void TestStatisticsBasic() {
     assert(seq2 != nullptr);
     double med2 = Statistics::Median(*seq2);
     assert(std::fabs(med2 - 3.0) < 1e-9);
+
+    // Та же выборка в списке (без непрерывного буфера) — те же результаты
+    Value items[4] = {Value(1.0), Value(2.0), Value(3.0), Value(4.0)};
+    MutableListSequence<Value> list(items, 4);
+    assert(std::fabs(Statistics::Mean(list) - mean) < 1e-9);
+    assert(std::fabs(Statistics::Variance(list) - var) < 1e-9);
+    assert(std::fabs(Statistics::Median(list) - med) < 1e-9);
+    assert(std::fabs(Statistics::Covariance(list, *seq) - var) < 1e-9);
 }
 
 // ========================= Тесты для Interpreter =========================
@@ -0,0 +1,337 @@
+// Сценарии для общих контейнеров (containers/), LazySequence и конвейера над ней.
+#include "BenchHarness.h"
+
+#include "dynamic_array.h"
+#include "sequence.h"
+#include "Lists.h"
+#include "UnrolledList.h"
+#include "Semester_3_Lab_1/LazySequence.h"
+#include "Semester_3_Lab_1/OnlineStatistics.h"
+#include "Semester_3_Lab_1/Streams.h"
+#include "Semester_3_Lab_1/AsyncStreams.h"
+#include "Semester_3_Lab_1/BinaryStreams.h"
+#include "Semester_3_Lab_1/PartitionedIngest.h"
+#include <cstdio>
+#include <fstream>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+    namespace {
+
+        template<typename List>
+        long long buildAndSumList(int n) {
+            List list;
+            for (int i = 0; i < n; i++) list.Append(i);
+            long long sum = 0;
+            for (int v : list) sum += v;
+            return sum;
+        }
+
+    }
+
+    void RunContainerBenchmarks(Runner& runner) {
+        const int n = static_cast<int>(runner.Scaled(1000000));
+
+        runner.Run("DynamicArray<int>/PushBack+sum", n, [n] {
+            DynamicArray<int> arr(0);
+            for (int i = 0; i < n; i++) arr.PushBack(i);
+            long long sum = 0;
+            for (int v : arr) sum += v;
+            return sum;
+        });
+
+        runner.Run("DynamicArray<int>/Insert(0) x1000", 1000, [] {
+            DynamicArray<int> arr(0);
+            for (int i = 0; i < 1000; i++) arr.Insert(0, i);
+            return static_cast<long long>(arr[0]);
+        });
+
+        runner.Run("MutableArraySequence<int>/Append+Get", n, [n] {
+            MutableArraySequence<int> seq;
+            for (int i = 0; i < n; i++) seq.Append(i);
+            long long sum = 0;
+            for (int i = 0; i < n; i++) sum += seq.Get(i);
+            return sum;
+        });
+
+        runner.Run("MutableArraySequence<int>/ForEach", n, [n] {
+            MutableArraySequence<int> seq;
+            seq.Reserve(n);
+            for (int i = 0; i < n; i++) seq.Append(i);
+            long long sum = 0;
+            seq.ForEach([&](const int& v) { sum += v; });
+            return sum;
+        });
+
+        const int immN = static_cast<int>(runner.Scaled(200000));
+        runner.Run("ImmutableArraySequence<int>/Append", immN, [immN] {
+            Sequence<int>* seq = new ImmutableArraySequence<int>();
+            for (int i = 0; i < immN; i++) {
+                Sequence<int>* next = seq->Append(i);
+                delete seq;
+                seq = next;
+            }
+            long long last = seq->GetLast();
+            delete seq;
+            return last;
+        });
+
+        runner.Run("LinkedList<int>/pool Append+sum", n, [n] {
+            return buildAndSumList<LinkedList<int>>(n);
+        });
+
+        runner.Run("LinkedList<int>/heap Append+sum", n, [n] {
+            return buildAndSumList<LinkedList<int, HeapNodeAllocator>>(n);
+        });
+
+        runner.Run("UnrolledList<int>/Append+sum", n, [n] {
+            return buildAndSumList<UnrolledList<int>>(n);
+        });
+
+        // Много коротких строк, как в поле Board: умещаются во встроенный буфер.
+        const int rows = n / 8;
+        runner.Run("MutableArraySequence<char>/8-char rows", rows, [rows] {
+            long long total = 0;
+            for (int r = 0; r < rows; r++) {
+                MutableArraySequence<char> row;
+                for (int c = 0; c < 8; c++) row.Append('.');
+                total += row.GetLength();
+            }
+            return total;
+        });
+
+        // Рекуррентная генерация: каждый элемент зависит от двух предыдущих.
+        const int lazyN = static_cast<int>(runner.Scaled(200000));
+        runner.Run("LazySequence<long long>/recurrence Get(last)", lazyN, [lazyN] {
+            LazySequence<long long> fib([](const LazySequence<long long>& s, int i) -> long long {
+                return i < 2 ? i : (s.Get(i - 1) + s.Get(i - 2)) % 1000000007;
+            }, lazyN);
+            return fib.Get(lazyN - 1);
+        });
+
+        // Последовательное чтение: генератор на элемент против блочного.
+        const int seqN = static_cast<int>(runner.Scaled(2000000));
+        runner.Run("LazySequence<int>/element gen sequential", seqN, [seqN] {
+            LazySequence<int> seq([](const LazySequence<int>&, int i) { return i ^ (i >> 3); }, seqN);
+            long long sum = 0;
+            for (int i = 0; i < seqN; i++) sum += seq.Get(i);
+            return sum;
+        });
+        runner.Run("LazySequence<int>/batch gen sequential", seqN, [seqN] {
+            LazySequence<int> seq([](const LazySequence<int>&, int start, int* out, int count) {
+                for (int k = 0; k < count; k++) out[k] = (start + k) ^ ((start + k) >> 3);
+            }, seqN);
+            long long sum = 0;
+            for (int i = 0; i < seqN; i++) sum += seq.Get(i);
+            return sum;
+        });
+
+        // Заполнение префикса генератором по индексу: один поток против всех ядер.
+        const int parallelN = static_cast<int>(runner.Scaled(20000000));
+        auto heavy = [](const LazySequence<int>&, long long start, int* out, int count) {
+            for (int k = 0; k < count; k++) {
+                unsigned x = static_cast<unsigned>(start + k);
+                for (int r = 0; r < 8; r++) x = x * 2654435761u + (x >> 13);
+                out[k] = static_cast<int>(x & 0xffff);
+            }
+        };
+        for (int threads : {1, 0}) {
+            std::string name = std::string("LazySequence<int>/materialize ") + (threads == 1 ? "1 thread" : "all cores");
+            runner.Run(name, parallelN, [parallelN, heavy, threads] {
+                LazySequence<int> seq(heavy, parallelN, LazySequence<int>::Access::Indexed, 4096);
+                seq.MaterializeParallel(parallelN, threads);
+                return static_cast<long long>(seq.Get(parallelN - 1));
+            });
+        }
+
+        // Общая последовательность, которую читают сразу несколько потоков:
+        // один достраивает блоки, остальные читают опубликованный префикс.
+        const int sharedN = static_cast<int>(runner.Scaled(4000000));
+        runner.Run("LazySequence<int>/4 concurrent readers", 4LL * sharedN, [sharedN, heavy] {
+            LazySequence<int> seq(heavy, sharedN, 4096);
+            seq.EnableConcurrentReads();
+            std::atomic<long long> total{0};
+            std::vector<std::thread> readers;
+            for (int r = 0; r < 4; r++) {
+                readers.emplace_back([&seq, &total, sharedN] {
+                    long long sum = 0;
+                    for (int i = 0; i < sharedN; i++) sum += seq.Get(i);
+                    total.fetch_add(sum);
+                });
+            }
+            for (std::thread& t : readers) t.join();
+            return total.load();
+        });
+
+        // Бесконечная рекуррентная последовательность с окном в два элемента:
+        // память постоянна при любом числе шагов.
+        const long long unboundedN = runner.Scaled(10000000);
+        runner.Run("LazySequence<ll>/unbounded fib window 2", unboundedN, [unboundedN] {
+            using Lazy = LazySequence<long long>;
+            Lazy fib([](const Lazy& s, long long start, long long* out, int count) {
+                for (int k = 0; k < count; k++) {
+                    long long i = start + k;
+                    long long a = i < 1 ? 0 : (k >= 1 ? out[k - 1] : s.GetAt(i - 1));
+                    long long b = i < 2 ? 0 : (k >= 2 ? out[k - 2] : s.GetAt(i - 2));
+                    out[k] = i < 2 ? i : (a + b) % 1000000007;
+                }
+            }, Lazy::Unbounded{2});
+            return fib.GetAt(unboundedN - 1);
+        });
+
+        // Where -> Map -> статистика: промежуточные массивы против слитого конвейера.
+        const int pipeN = static_cast<int>(runner.Scaled(2000000));
+        auto pipeSource = [](const LazySequence<int>&, long long start, int* out, int count) {
+            for (int k = 0; k < count; k++) out[k] = static_cast<int>((start + k) * 7919 % 10007);
+        };
+        runner.Run("Lazy where/map/stats via arrays", pipeN, [pipeN, pipeSource] {
+            LazySequence<int> seq(pipeSource, pipeN);
+            MutableArraySequence<int> filtered;
+            for (int i = 0; i < pipeN; i++) {
+                int x = seq.Get(i);
+                if (x % 3 != 0) filtered.Append(x);
+            }
+            MutableArraySequence<double> mapped;
+            for (int i = 0; i < filtered.GetLength(); i++) mapped.Append(filtered.Get(i) * 0.5);
+            OnlineStatistics<double> stats(true, true, true, false);
+            for (int i = 0; i < mapped.GetLength(); i++) stats.Add(mapped.Get(i));
+            return static_cast<long long>(stats.GetMean() * 1000);
+        });
+        runner.Run("Lazy where/map/stats pipeline", pipeN, [pipeN, pipeSource] {
+            LazySequence<int> seq(pipeSource, pipeN);
+            OnlineStatistics<double> stats(true, true, true, false);
+            seq.Where([](int x) { return x % 3 != 0; }).Map([](int x) { return x * 0.5; }).AddTo(stats);
+            return static_cast<long long>(stats.GetMean() * 1000);
+        });
+
+        // Произвольный доступ к последовательности длины 10^9 по замкнутой формуле.
+        const int randomN = static_cast<int>(runner.Scaled(1000000));
+        runner.Run("LazySequence<ll>/random Get len 1e9", randomN, [randomN] {
+            using Lazy = LazySequence<long long>;
+            Lazy seq([](const Lazy&, int start, long long* out, int count) {
+                for (int k = 0; k < count; k++) out[k] = 1LL * (start + k) * 7 % 1000003;
+            }, 1000000000, Lazy::Access::Random);
+            unsigned x = 12345;
+            long long sum = 0;
+            for (int i = 0; i < randomN; i++) {
+                x = x * 1664525u + 1013904223u;
+                // половина обращений — рядом с предыдущими, половина — куда угодно
+                int index = (i & 1) ? static_cast<int>(x % 1000000000u) : static_cast<int>(x % 65536u);
+                sum += seq.Get(index);
+            }
+            return sum;
+        });
+
+        // Текстовый поток чисел в статистику: TryRead + Add против ReadBlock + AddRange.
+        const int textN = static_cast<int>(runner.Scaled(1000000));
+        std::string text;
+        for (int i = 0; i < textN; i++) text += std::to_string(i * 37 % 100003) + ' ';
+        runner.Run("ReadOnlyStream<double>/TryRead >> to stats", textN, [&text] {
+            std::istringstream in(text);
+            ReadOnlyStream<double> stream(in, [](std::istream& is, double& x) { return static_cast<bool>(is >> x); });
+            OnlineStatistics<double> stats(true, true, true, false);
+            double x;
+            while (stream.TryRead(x)) stats.Add(x);
+            return static_cast<long long>(stats.GetMean() * 1000);
+        });
+        runner.Run("ReadOnlyStream<double>/ReadBlock to AddRange", textN, [&text] {
+            std::istringstream in(text);
+            ReadOnlyStream<double> stream(in, ReadOnlyStream<double>::BlockDeserializer(ParseTextBlock<double>));
+            OnlineStatistics<double> stats(true, true, true, false);
+            double block[4096];
+            std::size_t got;
+            while ((got = stream.ReadBlock(block, 4096)) > 0) stats.AddRange(block, got);
+            return static_cast<long long>(stats.GetMean() * 1000);
+        });
+        runner.Run("ReadOnlyStream<double>/prefetch to AddRange", textN, [&text] {
+            std::istringstream in(text);
+            ReadOnlyStream<double> stream(in, ReadOnlyStream<double>::BlockDeserializer(ParseTextBlock<double>));
+            AsyncReadOnlyStream<double, ReadOnlyStream<double>> prefetch(stream);
+            OnlineStatistics<double> stats(true, true, true, false);
+            const double* data;
+            std::size_t got;
+            while (prefetch.NextBlock(data, got)) stats.AddRange(data, got);
+            return static_cast<long long>(stats.GetMean() * 1000);
+        });
+
+        // Произвольный доступ к текстовому потоку через разреженный индекс смещений.
+        SparseOffsetIndex textIndex(1024);
+        {
+            std::istringstream in(text);
+            ReadOnlyStream<double> stream(in, ReadOnlyStream<double>::BlockDeserializer(ParseTextBlock<double>));
+            stream.AttachIndex(textIndex);
+            double block[4096];
+            while (stream.ReadBlock(block, 4096) > 0) {}
+        }
+        const int seeks = 1000;
+        runner.Run("ReadOnlyStream<double>/indexed Seek+Read", seeks, [&text, &textIndex, textN] {
+            std::istringstream in(text);
+            ReadOnlyStream<double> stream(in, ReadOnlyStream<double>::BlockDeserializer(ParseTextBlock<double>));
+            stream.AttachIndex(textIndex);
+            unsigned x = 12345;
+            long long sum = 0;
+            for (int i = 0; i < seeks; i++) {
+                x = x * 1664525u + 1013904223u;
+                stream.Seek(x % static_cast<unsigned>(textN));
+                sum += static_cast<long long>(stream.Read());
+            }
+            return sum;
+        });
+
+        // Весь файл целиком: последовательный разбор против разбиения по потокам.
+        const char* ingestFile = "bench_partitioned_ingest.tmp";
+        {
+            std::ofstream out(ingestFile, std::ios::binary);
+            out << text;
+        }
+        {
+            MappedFile mapped(ingestFile);
+            runner.Run("IngestPartitioned<double>/1 thread", textN, [&mapped] {
+                OnlineStatistics<double> stats(true, true, true, false);
+                IngestPartitioned(mapped, stats, 1);
+                return static_cast<long long>(stats.GetMean() * 1000);
+            });
+            runner.Run("IngestPartitioned<double>/all cores", textN, [&mapped] {
+                OnlineStatistics<double> stats(true, true, true, false);
+                IngestPartitioned(mapped, stats, 0, 64 * 1024);
+                return static_cast<long long>(stats.GetMean() * 1000);
+            });
+        }
+        std::remove(ingestFile);
+
+        // Тот же столбец в двоичном формате: загрузка без разбора и только по итогам блоков.
+        std::stringstream binary;
+        {
+            BinaryWriteOnlyStream<double> writer(binary);
+            for (int i = 0; i < textN; i++) writer.Write(i * 37 % 100003);
+        }
+        const std::string binaryBytes = binary.str();
+        runner.Run("BinaryStream<double>/ReadBlock to AddRange", textN, [&binaryBytes] {
+            std::istringstream in(binaryBytes);
+            BinaryReadOnlyStream<double> stream(in);
+            OnlineStatistics<double> stats(true, true, true, false);
+            double block[4096];
+            std::size_t got;
+            while ((got = stream.ReadBlock(block, 4096)) > 0) stats.AddRange(block, got);
+            return static_cast<long long>(stats.GetMean() * 1000);
+        });
+        runner.Run("BinaryStream<double>/mean from block sums", textN, [&binaryBytes] {
+            std::istringstream in(binaryBytes);
+            BinaryReadOnlyStream<double> stream(in);
+            BinaryBlockSummary<double> summary;
+            double sum = 0;
+            while (stream.PeekBlockSummary(summary)) {
+                sum += summary.sum;
+                stream.SkipBlock();
+            }
+            return static_cast<long long>(sum / stream.GetCount() * 1000);
+        });
+    }
+
+}
@@ -0,0 +1,194 @@
+#pragma once
+#include "AllocTracking.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Минимальная обвязка для микробенчмарков.
+//
+// Сценарий — функция без аргументов, выполняющая ops операций за один прогон и
+// возвращающая контрольную сумму (чтобы оптимизатор не выбросил работу).
+// Runner делает warmup холостых прогонов, затем repetitions замеров и считает
+// медиану и 95-й перцентиль времени прогона, нс на операцию, число выделений
+// памяти на операцию и пик занятой памяти (AllocTracking.h; bench всегда
+// собирается с учётом выделений).
+namespace bench {
+
+    struct Options {
+        int warmup = 1;
+        int repetitions = 7;
+        double scale = 1.0;          // множитель размеров задач (--scale)
+        std::string filter;          // подстрока имени сценария; пусто — все
+        std::string label;           // метка прогона (например, коммит) для CSV/JSON
+    };
+
+    struct Result {
+        std::string name;
+        long long ops = 0;           // операций за один прогон
+        int repetitions = 0;
+        double medianNs = 0;         // время прогона
+        double p95Ns = 0;
+        double minNs = 0;
+        double nsPerOp = 0;          // по медиане
+        double allocsPerOp = 0;
+        double bytesPerOp = 0;
+        long long peakBytes = 0;     // наибольший прирост занятой памяти за прогон
+    };
+
+    class Runner {
+    public:
+        explicit Runner(Options options) : options(std::move(options)) {}
+
+        const Options& GetOptions() const { return options; }
+
+        // Размер задачи с учётом --scale (не меньше 1).
+        long long Scaled(long long n) const {
+            long long scaled = static_cast<long long>(n * options.scale);
+            return scaled < 1 ? 1 : scaled;
+        }
+
+        template<typename Fn>
+        void Run(const std::string& name, long long ops, Fn&& body);
+
+        const std::vector<Result>& GetResults() const { return results; }
+
+        void WriteCsv(const std::string& path) const;
+        void WriteJson(const std::string& path) const;
+
+    private:
+        Options options;
+        std::vector<Result> results;
+        volatile long long sink = 0;
+
+        static void printHeader();
+        static void printRow(const Result& r);
+        static std::string escapeJson(const std::string& s);
+    };
+
+    // Перцентиль p (0..100) по отсортированной выборке методом ближайшего ранга.
+    inline double Percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0;
+        std::size_t rank = static_cast<std::size_t>(p / 100.0 * sorted.size() + 0.999999);
+        if (rank < 1) rank = 1;
+        if (rank > sorted.size()) rank = sorted.size();
+        return sorted[rank - 1];
+    }
+
+    template<typename Fn>
+    void Runner::Run(const std::string& name, long long ops, Fn&& body) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+        if (results.empty()) printHeader();
+
+        for (int i = 0; i < options.warmup; i++) sink = sink + body();
+
+        int reps = options.repetitions < 1 ? 1 : options.repetitions;
+        std::vector<double> times;
+        times.reserve(reps);
+        std::uint64_t allocs = 0, bytes = 0;
+        long long peak = 0;
+        for (int i = 0; i < reps; i++) {
+            AllocScope scope;
+            auto t0 = std::chrono::steady_clock::now();
+            sink = sink + body();
+            auto t1 = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+            allocs += scope.Allocations();
+            bytes += scope.Bytes();
+            peak = std::max<long long>(peak, scope.PeakBytes());
+        }
+
+        std::sort(times.begin(), times.end());
+        Result r;
+        r.name = name;
+        r.ops = ops < 1 ? 1 : ops;
+        r.repetitions = reps;
+        r.medianNs = Percentile(times, 50);
+        r.p95Ns = Percentile(times, 95);
+        r.minNs = times.front();
+        r.nsPerOp = r.medianNs / r.ops;
+        r.allocsPerOp = static_cast<double>(allocs) / reps / r.ops;
+        r.bytesPerOp = static_cast<double>(bytes) / reps / r.ops;
+        r.peakBytes = peak;
+        printRow(r);
+        results.push_back(std::move(r));
+    }
+
+    inline void Runner::printHeader() {
+        std::cout << std::left << std::setw(44) << "benchmark" << std::right
+                  << std::setw(12) << "ops" << std::setw(12) << "median ms" << std::setw(12) << "p95 ms"
+                  << std::setw(12) << "ns/op" << std::setw(12) << "allocs/op" << std::setw(12) << "peak KB" << "\n";
+    }
+
+    inline void Runner::printRow(const Result& r) {
+        std::cout << std::left << std::setw(44) << r.name << std::right
+                  << std::setw(12) << r.ops << std::fixed
+                  << std::setw(12) << std::setprecision(3) << r.medianNs / 1e6
+                  << std::setw(12) << std::setprecision(3) << r.p95Ns / 1e6
+                  << std::setw(12) << std::setprecision(2) << r.nsPerOp
+                  << std::setw(12) << std::setprecision(3) << r.allocsPerOp
+                  << std::setw(12) << std::setprecision(1) << r.peakBytes / 1024.0 << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    inline void Runner::WriteCsv(const std::string& path) const {
+        std::ofstream f(path, std::ios::trunc);
+        if (!f) {
+            std::cerr << "Cannot write " << path << "\n";
+            return;
+        }
+        f << "label,benchmark,ops,repetitions,median_ns,p95_ns,min_ns,ns_per_op,allocs_per_op,bytes_per_op,peak_bytes\n";
+        f << std::setprecision(10);
+        for (const Result& r : results) {
+            f << options.label << ',' << r.name << ',' << r.ops << ',' << r.repetitions << ','
+              << r.medianNs << ',' << r.p95Ns << ',' << r.minNs << ',' << r.nsPerOp << ','
+              << r.allocsPerOp << ',' << r.bytesPerOp << ',' << r.peakBytes << '\n';
+        }
+    }
+
+    inline std::string Runner::escapeJson(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    inline void Runner::WriteJson(const std::string& path) const {
+        std::ofstream f(path, std::ios::trunc);
+        if (!f) {
+            std::cerr << "Cannot write " << path << "\n";
+            return;
+        }
+        f << std::setprecision(10);
+        f << "{\n  \"label\": \"" << escapeJson(options.label) << "\",\n"
+          << "  \"warmup\": " << options.warmup << ",\n"
+          << "  \"repetitions\": " << options.repetitions << ",\n"
+          << "  \"scale\": " << options.scale << ",\n"
+          << "  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            f << "    {\"benchmark\": \"" << escapeJson(r.name) << "\", \"ops\": " << r.ops
+              << ", \"repetitions\": " << r.repetitions
+              << ", \"median_ns\": " << r.medianNs << ", \"p95_ns\": " << r.p95Ns
+              << ", \"min_ns\": " << r.minNs << ", \"ns_per_op\": " << r.nsPerOp
+              << ", \"allocs_per_op\": " << r.allocsPerOp << ", \"bytes_per_op\": " << r.bytesPerOp
+              << ", \"peak_bytes\": " << r.peakBytes << "}"
+              << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        f << "  ]\n}\n";
+    }
+
+    // Сценарии по областям: общие контейнеры, лабораторные 2-го и 3-го семестров.
+    void RunContainerBenchmarks(Runner& runner);
+    void RunSemester2Benchmarks(Runner& runner);
+    void RunSemester3Benchmarks(Runner& runner);
+
+}
@@ -0,0 +1,65 @@
+// Сценарии для лабораторных 2-го семестра: дек, дерево поиска, матрицы.
+#include "BenchHarness.h"
+
+#include "Semester_2_Lab_3/Matrix_MAS.h"
+#include "Semester_2_Lab_4/Tree.h"
+#include "Semester_2_Lab_5/Deque.h"
+
+#include <random>
+#include <vector>
+
+namespace bench {
+
+    void RunSemester2Benchmarks(Runner& runner) {
+        const int n = static_cast<int>(runner.Scaled(1000000));
+
+        runner.Run("Deque<int>/push_back+push_front+index", n, [n] {
+            Deque<int> d;
+            for (int i = 0; i < n / 2; i++) {
+                d.push_back(i);
+                d.push_front(-i);
+            }
+            long long sum = 0;
+            for (int i = 0; i < d.size(); i++) sum += d[i];
+            return sum;
+        });
+
+        runner.Run("Deque<int>/rotate_left", n, [n] {
+            Deque<int> d;
+            for (int i = 0; i < n; i++) d.push_back(i);
+            d.rotate_left(n / 3);
+            return static_cast<long long>(d.front());
+        });
+
+        // Несбалансированное дерево: ключи случайные, иначе оно вырождается в список.
+        const int treeN = static_cast<int>(runner.Scaled(200000));
+        std::vector<int> keys(treeN);
+        std::mt19937 rng(12345);
+        for (int& k : keys) k = static_cast<int>(rng() % 1000000000);
+
+        runner.Run("Tree<int>/insert+find random", treeN, [&keys] {
+            Tree<int> tree;
+            for (int k : keys) tree.insertEl(k);
+            long long found = 0;
+            for (int k : keys) found += tree.findEl(k);
+            return found;
+        });
+
+        const int dim = static_cast<int>(runner.Scaled(128));
+        std::vector<double> values(static_cast<std::size_t>(dim) * dim);
+        for (std::size_t i = 0; i < values.size(); i++)
+            values[i] = static_cast<double>(rng() % 1000) / 100.0 + (i % (dim + 1) == 0 ? dim * 10.0 : 0.0);
+        Matrix<double> a(dim, dim, values.data());
+
+        runner.Run("Matrix<double>/multiply NxN", 1LL * dim * dim * dim, [&a] {
+            Matrix<double> c = a * a;
+            return static_cast<long long>(c.getKNorm());
+        });
+
+        runner.Run("Matrix<double>/getInverse NxN", 1LL * dim * dim * dim, [&a] {
+            Matrix<double> inv = a.getInverse();
+            return static_cast<long long>(inv.getKNorm() * 1e6);
+        });
+    }
+
+}
@@ -0,0 +1,125 @@
+// Сценарии для лабораторных 3-го семестра: компоненты связности графа,
+// поле и ИИ крестиков-ноликов, интерпретатор ProbabilityScript.
+#include "BenchHarness.h"
+
+#include "Semester_3_Lab_2/AI.hpp"
+#include "Semester_3_Lab_2/Board.hpp"
+#include "Semester_3_Lab_3/ConnectedComponents.h"
+#include "Semester_3_Lab_3/Graphs.h"
+#include "Semester_3_Lab_Dop/interpreter.h"
+#include "Semester_3_Lab_Dop/lexer.h"
+#include "Semester_3_Lab_Dop/parser.h"
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace bench {
+
+    namespace {
+
+        // Случайный граф без петель и кратных рёбер (тот же генератор, что в --bench-graph).
+        void fillRandomGraph(AdjListGraph& g, int vertices, int edges) {
+            std::mt19937 rng(12345);
+            std::uniform_int_distribution<int> pick(0, vertices - 1);
+            int added = 0;
+            while (added < edges) {
+                int u = pick(rng), v = pick(rng);
+                if (u == v) continue;
+                try {
+                    g.AddEdge(u, v);
+                    ++added;
+                } catch (const std::logic_error&) {
+                    // повторное ребро — берём другую пару
+                }
+            }
+        }
+
+        // Ходы по расходящейся спирали от (0,0): поле растёт во все стороны.
+        long long playSpiral(int moves) {
+            Board board;
+            board.SetWinK(moves + 1);   // победа недостижима — ставим все ходы
+            int x = 0, y = 0, dx = 1, dy = 0, leg = 1, stepped = 0, turns = 0;
+            long long wins = 0;
+            for (int i = 0; i < moves; i++) {
+                char symbol = (i % 2 == 0) ? 'X' : 'O';
+                board.PlaceMove(x, y, symbol);
+                wins += board.CheckWin(x, y);
+                x += dx; y += dy;
+                if (++stepped == leg) {
+                    stepped = 0;
+                    int t = dx; dx = -dy; dy = t;
+                    if (++turns % 2 == 0) ++leg;
+                }
+            }
+            return wins + board.MaxX() - board.MinX();
+        }
+
+    }
+
+    void RunSemester3Benchmarks(Runner& runner) {
+        // DFS в cc рекурсивен: глубина до числа вершин гигантской компоненты,
+        // поэтому граф держим в пределах обычного стека.
+        const int vertices = static_cast<int>(runner.Scaled(20000));
+        const int edges = vertices * 2;
+
+        runner.Run("AdjListGraph/build random", edges, [vertices, edges] {
+            AdjListGraph g(vertices);
+            fillRandomGraph(g, vertices, edges);
+            return static_cast<long long>(g.VerticesCount());
+        });
+
+        AdjListGraph graph(vertices);
+        fillRandomGraph(graph, vertices, edges);
+
+        runner.Run("cc::ConnectedComponentsDFS", vertices + edges, [&graph] {
+            return static_cast<long long>(cc::ConnectedComponentsDFS(graph).size());
+        });
+
+        runner.Run("cc::ConnectedComponentsBFS", vertices + edges, [&graph] {
+            return static_cast<long long>(cc::ConnectedComponentsBFS(graph).size());
+        });
+
+        const int moves = static_cast<int>(runner.Scaled(2000));
+        runner.Run("Board/PlaceMove+CheckWin spiral", moves, [moves] {
+            return playSpiral(moves);
+        });
+
+        runner.Run("AI/FindBestMove alpha-beta depth 4", 1, [] {
+            Board board;
+            board.SetWinK(5);
+            board.PlaceMove(0, 0, 'X');
+            board.PlaceMove(1, 0, 'O');
+            board.PlaceMove(1, 1, 'X');
+            board.PlaceMove(0, 1, 'O');
+            AI ai;
+            ai.maxDepth = 4;
+            ai.maxCandidates = 12;
+            AIMove move = ai.FindBestMoveAlphaBeta(board, 'X');
+            return static_cast<long long>(move.x * 1000 + move.y) + ai.lastStatsAlpha.nodes;
+        });
+
+        const int iterations = static_cast<int>(runner.Scaled(20000));
+        const std::string script =
+            "s = 0\n"
+            "repeat " + std::to_string(iterations) + " {\n"
+            "    s = s + 1\n"
+            "    collect A normal(0, 1)\n"
+            "}\n"
+            "print(get_stat(\"mean\", A))\n"
+            "print(get_stat(\"median\", A))\n";
+
+        runner.Run("Interpreter/repeat+collect+get_stat", iterations, [&script] {
+            Lexer lexer(script);
+            Parser parser(lexer);
+            Program program = parser.ParseProgram();
+            std::ostringstream out;
+            Interpreter interp(42);
+            interp.SetOutputStream(out);
+            interp.ExecuteProgram(program);
+            return static_cast<long long>(out.str().size());
+        });
+    }
+
+}
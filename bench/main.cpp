@@ -0,0 +1,82 @@
+// Набор микробенчмарков по всем контейнерам и алгоритмам репозитория.
+//
+//   bench [--filter S] [--reps N] [--warmup N] [--scale X] [--label L]
+//         [--csv FILE] [--json FILE]
+//
+// Результаты печатаются таблицей и сохраняются в CSV и JSON
+// (по умолчанию bench_results.csv / bench_results.json) — для сравнения
+// между коммитами удобно задавать --label, например хэш коммита.
+
+#include "BenchHarness.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+    void printUsage() {
+        std::cout << "Usage: bench [--filter S] [--reps N] [--warmup N] [--scale X] [--label L]\n"
+                     "             [--csv FILE] [--json FILE]\n"
+                     "  --filter S   run only benchmarks whose name contains S\n"
+                     "  --reps N     measured repetitions per benchmark (default 7)\n"
+                     "  --warmup N   unmeasured warm-up runs (default 1)\n"
+                     "  --scale X    multiply problem sizes by X (default 1)\n"
+                     "  --label L    run label stored in CSV/JSON (e.g. commit hash)\n"
+                     "  --csv FILE   CSV output (default bench_results.csv)\n"
+                     "  --json FILE  JSON output (default bench_results.json)\n";
+    }
+
+}
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    std::string csvPath = "bench_results.csv";
+    std::string jsonPath = "bench_results.json";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (arg == "--filter") options.filter = value;
+        else if (arg == "--reps") options.repetitions = std::atoi(value);
+        else if (arg == "--warmup") options.warmup = std::atoi(value);
+        else if (arg == "--scale") options.scale = std::atof(value);
+        else if (arg == "--label") options.label = value;
+        else if (arg == "--csv") csvPath = value;
+        else if (arg == "--json") jsonPath = value;
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.repetitions < 1 || options.warmup < 0 || options.scale <= 0) {
+        std::cerr << "Error: need --reps >= 1, --warmup >= 0, --scale > 0\n";
+        return 1;
+    }
+
+    bench::Runner runner(options);
+    bench::RunContainerBenchmarks(runner);
+    bench::RunSemester2Benchmarks(runner);
+    bench::RunSemester3Benchmarks(runner);
+
+    if (runner.GetResults().empty()) {
+        std::cout << "No benchmarks match filter \"" << options.filter << "\"\n";
+        return 0;
+    }
+    runner.WriteCsv(csvPath);
+    runner.WriteJson(jsonPath);
+    std::cout << "Saved " << runner.GetResults().size() << " results to "
+              << csvPath << " and " << jsonPath << "\n";
+    return 0;
+}
@@ -0,0 +1,145 @@
+// Подмена глобальных operator new/delete для AllocTracking.h.
+//
+// Память берётся из malloc с заголовком перед блоком, где записан размер:
+// delete без размера (а таких большинство) тоже знает, сколько байт вернуть,
+// и текущий/пиковый объём считается точно. Заменены все формы (обычная,
+// массив, nothrow, с выравниванием), иначе часть выделений прошла бы мимо счётчиков.
+#include "AllocTracking.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace {
+
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> deallocations{0};
+    std::atomic<std::uint64_t> bytesAllocated{0};
+    std::atomic<std::int64_t> liveBytes{0};
+    std::atomic<std::int64_t> peakBytes{0};
+
+    constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+    void raisePeak(std::int64_t value) {
+        std::int64_t peak = peakBytes.load(std::memory_order_relaxed);
+        while (value > peak && !peakBytes.compare_exchange_weak(peak, value, std::memory_order_relaxed)) {}
+    }
+
+    void onAllocate(std::size_t size) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+        std::int64_t live = liveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed)
+                          + static_cast<std::int64_t>(size);
+        raisePeak(live);
+    }
+
+    void onDeallocate(std::size_t size) {
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    }
+
+    // Блок с выравниванием больше kHeader; освобождается freeAligned. На Windows
+    // posix_memalign нет, а память _aligned_malloc нельзя отдавать free.
+    void* mallocAligned(std::size_t size, std::size_t align) noexcept {
+#if defined(_WIN32)
+        return _aligned_malloc(size, align);
+#else
+        void* base = nullptr;
+        return posix_memalign(&base, align, size) == 0 ? base : nullptr;
+#endif
+    }
+
+    void freeAligned(void* base) noexcept {
+#if defined(_WIN32)
+        _aligned_free(base);
+#else
+        std::free(base);
+#endif
+    }
+
+    // header — сколько байт перед пользовательским блоком (не меньше sizeof(size_t)
+    // и кратно выравниванию); размер лежит в последних байтах заголовка.
+    // Выравнивание больше kHeader бывает только вместе с header == align.
+    void* allocate(std::size_t size, std::size_t header, std::size_t align) noexcept {
+        void* base = align <= kHeader ? std::malloc(header + size) : mallocAligned(header + size, align);
+        if (!base) return nullptr;
+        unsigned char* user = static_cast<unsigned char*>(base) + header;
+        reinterpret_cast<std::size_t*>(user)[-1] = size;
+        onAllocate(size);
+        return user;
+    }
+
+    void deallocate(void* p, std::size_t header) noexcept {
+        if (!p) return;
+        unsigned char* user = static_cast<unsigned char*>(p);
+        onDeallocate(reinterpret_cast<std::size_t*>(user)[-1]);
+        if (header > kHeader) freeAligned(user - header);
+        else std::free(user - header);
+    }
+
+    std::size_t alignedHeader(std::align_val_t al) {
+        std::size_t align = static_cast<std::size_t>(al);
+        return align > kHeader ? align : kHeader;
+    }
+
+    void* orThrow(void* p) {
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+}
+
+AllocCounters CurrentAllocCounters() {
+    AllocCounters c;
+    c.allocations = allocations.load(std::memory_order_relaxed);
+    c.deallocations = deallocations.load(std::memory_order_relaxed);
+    c.bytesAllocated = bytesAllocated.load(std::memory_order_relaxed);
+    c.liveBytes = liveBytes.load(std::memory_order_relaxed);
+    c.peakBytes = peakBytes.load(std::memory_order_relaxed);
+    return c;
+}
+
+std::int64_t ExchangePeakBytes(std::int64_t peak) {
+    return peakBytes.exchange(peak, std::memory_order_relaxed);
+}
+
+void RaisePeakBytes(std::int64_t peak) {
+    raisePeak(peak);
+}
+
+void* operator new(std::size_t size) { return orThrow(allocate(size, kHeader, kHeader)); }
+void* operator new[](std::size_t size) { return orThrow(allocate(size, kHeader, kHeader)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, kHeader, kHeader); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, kHeader, kHeader); }
+
+void* operator new(std::size_t size, std::align_val_t al) {
+    return orThrow(allocate(size, alignedHeader(al), alignedHeader(al)));
+}
+void* operator new[](std::size_t size, std::align_val_t al) {
+    return orThrow(allocate(size, alignedHeader(al), alignedHeader(al)));
+}
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return allocate(size, alignedHeader(al), alignedHeader(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return allocate(size, alignedHeader(al), alignedHeader(al));
+}
+
+void operator delete(void* p) noexcept { deallocate(p, kHeader); }
+void operator delete[](void* p) noexcept { deallocate(p, kHeader); }
+void operator delete(void* p, std::size_t) noexcept { deallocate(p, kHeader); }
+void operator delete[](void* p, std::size_t) noexcept { deallocate(p, kHeader); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { deallocate(p, kHeader); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { deallocate(p, kHeader); }
+
+void operator delete(void* p, std::align_val_t al) noexcept { deallocate(p, alignedHeader(al)); }
+void operator delete[](void* p, std::align_val_t al) noexcept { deallocate(p, alignedHeader(al)); }
+void operator delete(void* p, std::size_t, std::align_val_t al) noexcept { deallocate(p, alignedHeader(al)); }
+void operator delete[](void* p, std::size_t, std::align_val_t al) noexcept { deallocate(p, alignedHeader(al)); }
+void operator delete(void* p, std::align_val_t al, const std::nothrow_t&) noexcept { deallocate(p, alignedHeader(al)); }
+void operator delete[](void* p, std::align_val_t al, const std::nothrow_t&) noexcept { deallocate(p, alignedHeader(al)); }
@@ -0,0 +1,64 @@
+#ifndef ALLOC_TRACKING_H
+#define ALLOC_TRACKING_H
+
+#include <cstdint>
+
+// Необязательный учёт выделений памяти.
+//
+// Включается сборкой с AllocTracking.cpp и макросом ALLOC_TRACKING
+// (в CMake: -DENABLE_ALLOC_TRACKING=ON для лабораторных; bench — всегда).
+// Тогда глобальные operator new/delete подменены и ведут счётчики: число
+// выделений и освобождений, запрошенные байты, текущий и пиковый объём.
+// Без ALLOC_TRACKING счётчики всегда нулевые, а AllocTrackingEnabled() == false —
+// код отчётов компилируется одинаково в обоих режимах.
+
+struct AllocCounters {
+    std::uint64_t allocations = 0;      // вызовов operator new
+    std::uint64_t deallocations = 0;    // вызовов operator delete с ненулевым указателем
+    std::uint64_t bytesAllocated = 0;   // всего запрошено байт
+    std::int64_t liveBytes = 0;         // выделено и ещё не освобождено
+    std::int64_t peakBytes = 0;         // максимум liveBytes
+};
+
+#ifdef ALLOC_TRACKING
+constexpr bool AllocTrackingEnabled() { return true; }
+AllocCounters CurrentAllocCounters();
+// Для AllocScope: заменить отсчёт пика значением peak и вернуть прежний пик;
+// RaisePeakBytes поднимает пик до peak, если он ниже.
+std::int64_t ExchangePeakBytes(std::int64_t peak);
+void RaisePeakBytes(std::int64_t peak);
+#else
+constexpr bool AllocTrackingEnabled() { return false; }
+inline AllocCounters CurrentAllocCounters() { return {}; }
+inline std::int64_t ExchangePeakBytes(std::int64_t) { return 0; }
+inline void RaisePeakBytes(std::int64_t) {}
+#endif
+
+// Счётчики на время жизни области видимости:
+//
+//     AllocScope scope;
+//     seq.Append(x);
+//     std::cout << scope.Allocations() << " allocations per Append\n";
+//
+// PeakBytes() — наибольший прирост занятой памяти относительно начала области.
+// Вложенные области допустимы: по выходу из внутренней глобальный пик
+// восстанавливается с учётом всего, что было до неё.
+class AllocScope {
+public:
+    AllocScope() : start(CurrentAllocCounters()), outerPeak(ExchangePeakBytes(start.liveBytes)) {}
+    ~AllocScope() { RaisePeakBytes(outerPeak); }
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    std::uint64_t Allocations() const { return CurrentAllocCounters().allocations - start.allocations; }
+    std::uint64_t Deallocations() const { return CurrentAllocCounters().deallocations - start.deallocations; }
+    std::uint64_t Bytes() const { return CurrentAllocCounters().bytesAllocated - start.bytesAllocated; }
+    std::int64_t PeakBytes() const { return CurrentAllocCounters().peakBytes - start.liveBytes; }
+
+private:
+    AllocCounters start;
+    std::int64_t outerPeak;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef BLOCK_CACHE_H
+#define BLOCK_CACHE_H
+
+#include "dynamic_array.h"
+#include <stdexcept>
+
+// LRU-кэш блоков по blockSize элементов, ключ — неотрицательный номер блока.
+// Держит не больше maxBlocks блоков; память под блок выделяется при первой
+// вставке в слот и дальше переиспользуется вытесненными блоками, так что
+// занятый объём пропорционален числу реально тронутых блоков.
+//
+// Поиск — открытая адресация (линейное пробирование, удаление сдвигом без
+// «надгробий»), порядок использования — двусвязный список по номерам слотов.
+template<typename T>
+class BlockCache {
+public:
+    BlockCache(int blockSize, int maxBlocks);
+    ~BlockCache();
+
+    BlockCache(const BlockCache<T>&) = delete;
+    BlockCache<T>& operator=(const BlockCache<T>&) = delete;
+
+    int GetBlockSize() const { return blockSize; }
+    int GetMaxBlocks() const { return maxBlocks; }
+    int GetCachedBlocks() const { return cached; }
+
+    // Блок key или nullptr; найденный блок становится самым свежим.
+    T* Find(int key);
+    // Место под блок key (которого нет в кэше); при переполнении вытесняется
+    // самый давно использованный. Содержимое заполняет вызывающий.
+    T* Insert(int key);
+    // Убрать блок key (например, если его не удалось заполнить).
+    void Erase(int key);
+    void Clear();
+
+private:
+    static constexpr int kEmpty = -1;
+
+    int blockSize;
+    int maxBlocks;
+    int used;       // слотов с выделенной памятью
+    int cached;     // слотов с действительным ключом
+    int head;       // самый свежий слот
+    int tail;       // самый давний слот
+    unsigned mask;  // размер таблицы - 1
+
+    DynamicArray<int> keys;    // ключ слота или kEmpty
+    DynamicArray<int> prev;
+    DynamicArray<int> next;
+    DynamicArray<T*> blocks;
+    DynamicArray<int> table;   // номер слота или kEmpty
+
+    unsigned bucket(int key) const { return (static_cast<unsigned>(key) * 2654435761u) & mask; }
+    int lookup(int key) const;
+    void tableErase(int key);
+    void unlink(int slot);
+    void pushFront(int slot);
+    void pushBack(int slot);
+};
+
+template<typename T>
+BlockCache<T>::BlockCache(int blockSize, int maxBlocks)
+    : blockSize(blockSize),
+      maxBlocks(maxBlocks),
+      used(0),
+      cached(0),
+      head(kEmpty),
+      tail(kEmpty),
+      mask(0),
+      keys(0),
+      prev(0),
+      next(0),
+      blocks(0),
+      table(0)
+{
+    if (blockSize <= 0 || maxBlocks <= 0) {
+        throw std::invalid_argument("block size and block count must be positive");
+    }
+    unsigned tableSize = 2;
+    while (tableSize < 2u * static_cast<unsigned>(maxBlocks)) tableSize *= 2;
+    mask = tableSize - 1;
+    table.Resize(static_cast<int>(tableSize));
+    for (int& t : table) t = kEmpty;
+}
+
+template<typename T>
+BlockCache<T>::~BlockCache() {
+    for (int i = 0; i < used; ++i) delete[] blocks[i];
+}
+
+template<typename T>
+int BlockCache<T>::lookup(int key) const {
+    for (unsigned b = bucket(key);; b = (b + 1) & mask) {
+        int slot = table.UncheckedGet(static_cast<int>(b));
+        if (slot == kEmpty) return kEmpty;
+        if (keys.UncheckedGet(slot) == key) return slot;
+    }
+}
+
+// Удаление из таблицы с линейным пробированием: последующие элементы цепочки
+// сдвигаются на освободившееся место, если их «родная» корзина не между ними.
+template<typename T>
+void BlockCache<T>::tableErase(int key) {
+    unsigned hole = bucket(key);
+    while (keys[table[static_cast<int>(hole)]] != key) hole = (hole + 1) & mask;
+    for (unsigned b = (hole + 1) & mask;; b = (b + 1) & mask) {
+        int slot = table[static_cast<int>(b)];
+        if (slot == kEmpty) break;
+        unsigned home = bucket(keys[slot]);
+        bool stays = hole <= b ? (hole < home && home <= b) : (hole < home || home <= b);
+        if (!stays) {
+            table[static_cast<int>(hole)] = slot;
+            hole = b;
+        }
+    }
+    table[static_cast<int>(hole)] = kEmpty;
+}
+
+template<typename T>
+void BlockCache<T>::unlink(int slot) {
+    if (prev[slot] != kEmpty) next[prev[slot]] = next[slot]; else head = next[slot];
+    if (next[slot] != kEmpty) prev[next[slot]] = prev[slot]; else tail = prev[slot];
+}
+
+template<typename T>
+void BlockCache<T>::pushFront(int slot) {
+    prev[slot] = kEmpty;
+    next[slot] = head;
+    if (head != kEmpty) prev[head] = slot; else tail = slot;
+    head = slot;
+}
+
+template<typename T>
+void BlockCache<T>::pushBack(int slot) {
+    next[slot] = kEmpty;
+    prev[slot] = tail;
+    if (tail != kEmpty) next[tail] = slot; else head = slot;
+    tail = slot;
+}
+
+template<typename T>
+T* BlockCache<T>::Find(int key) {
+    int slot = lookup(key);
+    if (slot == kEmpty) return nullptr;
+    if (slot != head) {
+        unlink(slot);
+        pushFront(slot);
+    }
+    return blocks[slot];
+}
+
+template<typename T>
+T* BlockCache<T>::Insert(int key) {
+    if (key < 0) {
+        throw std::out_of_range("block key must be non-negative");
+    }
+    int slot;
+    if (tail != kEmpty && keys[tail] == kEmpty) {
+        slot = tail;                        // освобождённый через Erase
+        unlink(slot);
+    } else if (used < maxBlocks) {
+        T* block = new T[blockSize];
+        slot = used++;
+        keys.PushBack(kEmpty);
+        prev.PushBack(kEmpty);
+        next.PushBack(kEmpty);
+        blocks.PushBack(block);
+    } else {
+        slot = tail;                        // вытесняем самый давний
+        unlink(slot);
+        tableErase(keys[slot]);
+        keys[slot] = kEmpty;
+        --cached;
+    }
+
+    keys[slot] = key;
+    unsigned b = bucket(key);
+    while (table[static_cast<int>(b)] != kEmpty) b = (b + 1) & mask;
+    table[static_cast<int>(b)] = slot;
+    pushFront(slot);
+    ++cached;
+    return blocks[slot];
+}
+
+template<typename T>
+void BlockCache<T>::Erase(int key) {
+    int slot = lookup(key);
+    if (slot == kEmpty) return;
+    tableErase(key);
+    keys[slot] = kEmpty;
+    --cached;
+    unlink(slot);
+    pushBack(slot);
+}
+
+template<typename T>
+void BlockCache<T>::Clear() {
+    for (int& t : table) t = kEmpty;
+    head = tail = kEmpty;
+    for (int slot = 0; slot < used; ++slot) {
+        keys[slot] = kEmpty;
+        pushBack(slot);
+    }
+    cached = 0;
+}
+
+#endif
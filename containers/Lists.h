@@ -0,0 +1,483 @@
+#ifndef LISTS_H
+#define LISTS_H
+
+#include "sequence.h"
+#include "NodePool.h"
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// NodeAllocator — откуда берётся память под узлы (см. NodePool.h).
+// По умолчанию узлы списка живут в его собственном NodePool.
+template<typename T, template<typename> class NodeAllocator = NodePool>
+class LinkedList {
+private:
+    struct Node {
+        T data;
+        Node* next;
+        explicit Node(const T& value) : data(value), next(nullptr) {}
+        explicit Node(T&& value) : data(std::move(value)), next(nullptr) {}
+    };
+
+    Node* head;
+    Node* tail;
+    int size;
+    NodeAllocator<Node> pool;
+
+    Node* makeNode(const T& value) {
+        void* mem = pool.Allocate();
+        try {
+            return new (mem) Node(value);
+        } catch (...) {
+            pool.Deallocate(mem);
+            throw;
+        }
+    }
+
+    // Если пул освобождает память сам, а деструктор T тривиален,
+    // обходить узлы не нужно: Release() работает за O(#блоков).
+    void Clear() {
+        constexpr bool skipWalk = NodeAllocator<Node>::kBulkRelease && std::is_trivially_destructible_v<T>;
+        if constexpr (!skipWalk) {
+            Node* cur = head;
+            while (cur) {
+                Node* nxt = cur->next;
+                cur->~Node();
+                if constexpr (!NodeAllocator<Node>::kBulkRelease) pool.Deallocate(cur);
+                cur = nxt;
+            }
+        }
+        pool.Release();
+        head = tail = nullptr;
+        size = 0;
+    }
+
+    // Перемещение пула забирает только блоки из кучи; узлы из его встроенного
+    // буфера остаются внутри other. Переносим их в те же ячейки нашего пула и
+    // перевешиваем ссылки на них (head, next предшественника, tail). Встроенные
+    // ячейки выдаются первыми, так что обычно это голова списка и обход короткий.
+    void takeFrom(LinkedList& other) noexcept {
+        head = other.head;
+        tail = other.tail;
+        size = other.size;
+        if constexpr (NodeAllocator<Node>::kInlineNodes > 0) {
+            int inlineCount = other.pool.InlineInUse();
+            pool = std::move(other.pool);
+            int left = inlineCount;
+            Node* prev = nullptr;
+            for (Node* cur = head; cur && left > 0; prev = cur, cur = cur->next) {
+                int slot = other.pool.InlineIndex(cur);
+                if (slot < 0) continue;
+                Node* moved = new (pool.InlineSlot(slot)) Node(std::move(cur->data));
+                moved->next = cur->next;
+                cur->~Node();
+                if (prev) prev->next = moved; else head = moved;
+                if (tail == cur) tail = moved;
+                cur = moved;
+                --left;
+            }
+            pool.AdoptInline(inlineCount);
+        } else {
+            pool = std::move(other.pool);
+        }
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+public:
+    // Forward-итераторы: шаг — переход по next, обход всего списка O(n).
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() : node(nullptr) {}
+        explicit ConstIterator(const Node* n) : node(n) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+        ConstIterator& operator++() { node = node->next; return *this; }
+        ConstIterator operator++(int) { ConstIterator tmp = *this; node = node->next; return tmp; }
+        bool operator==(const ConstIterator& other) const { return node == other.node; }
+        bool operator!=(const ConstIterator& other) const { return node != other.node; }
+
+    private:
+        const Node* node;
+    };
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() : node(nullptr) {}
+        explicit Iterator(Node* n) : node(n) {}
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+        Iterator& operator++() { node = node->next; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; node = node->next; return tmp; }
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+        operator ConstIterator() const { return ConstIterator(node); }
+
+    private:
+        Node* node;
+    };
+
+    // --- ctors/dtor ---
+    LinkedList() : head(nullptr), tail(nullptr), size(0) {}
+
+    LinkedList(T* items, int count) : LinkedList() {
+        if (count < 0) throw std::invalid_argument("count < 0");
+        for (int i = 0; i < count; ++i) Append(items[i]);
+    }
+
+    LinkedList(const LinkedList& other) : LinkedList() {
+        for (Node* cur = other.head; cur; cur = cur->next) Append(cur->data);
+    }
+
+    LinkedList(LinkedList&& other) noexcept : LinkedList() {
+        takeFrom(other);
+    }
+
+    ~LinkedList() { Clear(); }
+
+    // --- assignment ---
+    LinkedList& operator=(const LinkedList& other) {
+        if (this != &other) {
+            Clear();
+            for (Node* cur = other.head; cur; cur = cur->next) Append(cur->data);
+        }
+        return *this;
+    }
+
+    LinkedList& operator=(LinkedList&& other) noexcept {
+        if (this != &other) {
+            Clear();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    // --- basic ops ---
+    int GetLength() const { return size; }
+
+    T Get(int index) const {
+        if (index < 0 || index >= size) throw std::out_of_range("Index out of range");
+        Node* cur = head;
+        for (int i = 0; i < index; ++i) cur = cur->next;
+        return cur->data;
+    }
+
+    T GetFirst() const {
+        if (!head) throw std::out_of_range("List is empty");
+        return head->data;
+    }
+
+    T GetLast() const {
+        if (!tail) throw std::out_of_range("List is empty");
+        return tail->data;
+    }
+
+    void Append(const T& item) {
+        Node* node = makeNode(item);
+        if (!tail) { head = tail = node; }
+        else { tail->next = node; tail = node; }
+        ++size;
+    }
+
+    void Prepend(const T& item) {
+        Node* node = makeNode(item);
+        node->next = head;
+        head = node;
+        if (!tail) tail = head;
+        ++size;
+    }
+
+    void InsertAt(int index, const T& item) {
+        if (index < 0 || index > size) throw std::out_of_range("Index out of range");
+        if (index == 0) { Prepend(item); return; }
+        if (index == size) { Append(item); return; }
+        Node* cur = head;
+        for (int i = 0; i < index - 1; ++i) cur = cur->next;
+        Node* node = makeNode(item);
+        node->next = cur->next;
+        cur->next = node;
+        ++size;
+    }
+
+    // --- utility builders ---
+    // Возвращает НОВЫЙ список [start..end] (включительно).
+    LinkedList* GetSubList(int startIndex, int endIndex) const {
+        if (startIndex < 0 || endIndex < 0 || startIndex > endIndex || endIndex >= size)
+            throw std::out_of_range("Index out of range");
+        auto* res = new LinkedList();
+        Node* cur = head;
+        for (int i = 0; i < startIndex; ++i) cur = cur->next;
+        for (int i = startIndex; i <= endIndex; ++i) {
+            res->Append(cur->data);
+            cur = cur->next;
+        }
+        return res;
+    }
+
+    // Возвращает НОВЫЙ список = this + list (глубокая конкатенация).
+    LinkedList* Concat(const LinkedList* list) const {
+        auto* res = new LinkedList();
+        for (Node* cur = head; cur; cur = cur->next) res->Append(cur->data);
+        if (list) {
+            for (Node* cur = list->head; cur; cur = cur->next) res->Append(cur->data);
+        }
+        return res;
+    }
+
+    // --- iteration ---
+    Iterator begin() { return Iterator(head); }
+    Iterator end() { return Iterator(nullptr); }
+    ConstIterator begin() const { return ConstIterator(head); }
+    ConstIterator end() const { return ConstIterator(nullptr); }
+};
+
+// ------------------------- ListSequence -------------------------
+
+template<typename T>
+class ListSequence : public Sequence<T> {
+protected:
+    LinkedList<T>* items;
+    unsigned long long layoutVersion;     // см. Sequence::GetLayoutVersion
+
+    class ListCursor;
+
+public:
+    ListSequence();
+    ListSequence(T* data, int count);
+    ListSequence(const ListSequence<T>& other);
+    virtual ~ListSequence();
+
+    T Get(int index) const override;
+    int GetLength() const override;
+    T GetFirst() const override;
+    T GetLast() const override;
+
+    Sequence<T>* Append(T item) override;
+    Sequence<T>* Prepend(T item) override;
+    Sequence<T>* InsertAt(int index, T item) override;
+    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override;
+    Sequence<T>* Concat(const Sequence<T>& other) const override;
+
+    virtual Sequence<T>* CreateFromArray(T* data, int size) const = 0;
+    virtual Sequence<T>* Instance() const = 0;
+    virtual Sequence<T>* Clone() const = 0;
+
+    std::unique_ptr<typename Sequence<T>::Cursor> CreateCursor(int startIndex = 0) const override;
+    void ForEach(const std::function<void(const T&)>& action) const override;
+    unsigned long long GetLayoutVersion() const override { return layoutVersion; }
+
+    typename LinkedList<T>::ConstIterator begin() const { return items->begin(); }
+    typename LinkedList<T>::ConstIterator end() const { return items->end(); }
+};
+
+template<typename T>
+class ListSequence<T>::ListCursor : public Sequence<T>::Cursor {
+public:
+    explicit ListCursor(typename LinkedList<T>::ConstIterator start) : cur(start) {}
+    bool IsValid() const override { return cur != typename LinkedList<T>::ConstIterator(); }
+    T Current() const override { return *cur; }
+    void Next() override { ++cur; }
+    typename Sequence<T>::Cursor* Clone() const override { return new ListCursor(*this); }
+private:
+    typename LinkedList<T>::ConstIterator cur;
+};
+
+template<typename T>
+ListSequence<T>::ListSequence() : items(new LinkedList<T>()), layoutVersion(0) {}
+
+template<typename T>
+ListSequence<T>::ListSequence(T* data, int count)
+    : items(new LinkedList<T>(data, count)), layoutVersion(0) {}
+
+template<typename T>
+ListSequence<T>::ListSequence(const ListSequence<T>& other)
+    : items(new LinkedList<T>(*other.items)), layoutVersion(0) {}
+
+template<typename T>
+ListSequence<T>::~ListSequence() { delete items; }
+
+template<typename T>
+T ListSequence<T>::Get(int index) const { return items->Get(index); }
+
+template<typename T>
+int ListSequence<T>::GetLength() const { return items->GetLength(); }
+
+template<typename T>
+T ListSequence<T>::GetFirst() const { return items->GetFirst(); }
+
+template<typename T>
+T ListSequence<T>::GetLast() const { return items->GetLast(); }
+
+template<typename T>
+std::unique_ptr<typename Sequence<T>::Cursor> ListSequence<T>::CreateCursor(int startIndex) const {
+    if (startIndex < 0 || startIndex > GetLength())
+        throw std::out_of_range("Index out of range");
+    auto it = items->begin();
+    for (int i = 0; i < startIndex; i++) ++it;
+    return std::make_unique<ListCursor>(it);
+}
+
+template<typename T>
+void ListSequence<T>::ForEach(const std::function<void(const T&)>& action) const {
+    for (const T& value : *items) {
+        action(value);
+    }
+}
+
+template<typename T>
+Sequence<T>* ListSequence<T>::Append(T item) {
+    int size = GetLength();
+    T* newData = new T[size + 1];
+    int i = 0;
+    for (const T& value : *items) newData[i++] = value;
+    newData[size] = item;
+    auto* result = CreateFromArray(newData, size + 1);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* ListSequence<T>::Prepend(T item) {
+    int size = GetLength();
+    T* newData = new T[size + 1];
+    newData[0] = item;
+    int i = 1;
+    for (const T& value : *items) newData[i++] = value;
+    auto* result = CreateFromArray(newData, size + 1);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* ListSequence<T>::InsertAt(int index, T item) {
+    int size = GetLength();
+    if (index < 0 || index > size)
+        throw std::out_of_range("Index out of range");
+    T* newData = new T[size + 1];
+    int i = 0;
+    for (const T& value : *items) {
+        if (i == index) newData[i++] = item;
+        newData[i++] = value;
+    }
+    if (index == size) newData[size] = item;
+    auto* result = CreateFromArray(newData, size + 1);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* ListSequence<T>::GetSubsequence(int startIndex, int endIndex) const {
+    int size = endIndex - startIndex + 1;
+    if (startIndex < 0 || endIndex >= GetLength() || startIndex > endIndex)
+        throw std::out_of_range("Index out of range");
+    T* newData = new T[size];
+    auto it = items->begin();
+    for (int i = 0; i < startIndex; i++) ++it;
+    for (int i = 0; i < size; i++, ++it) newData[i] = *it;
+    auto* result = CreateFromArray(newData, size);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* ListSequence<T>::Concat(const Sequence<T>& other) const {
+    int size = GetLength() + other.GetLength();
+    T* newData = new T[size];
+    int i = 0;
+    for (const T& value : *items) newData[i++] = value;
+    other.ForEach([&](const T& value) { newData[i++] = value; });
+    auto* result = CreateFromArray(newData, size);
+    delete[] newData;
+    return result;
+}
+
+// ------------------------- Immutable -------------------------
+
+template<typename T>
+class ImmutableListSequence : public ListSequence<T> {
+public:
+    ImmutableListSequence() : ListSequence<T>() {}
+    ImmutableListSequence(T* data, int count) : ListSequence<T>(data, count) {}
+    ImmutableListSequence(const ImmutableListSequence<T>& other) : ListSequence<T>(other) {}
+
+    Sequence<T>* CreateFromArray(T* data, int size) const override {
+        return new ImmutableListSequence<T>(data, size);
+    }
+
+    Sequence<T>* Instance() const override {
+        return new ImmutableListSequence<T>();
+    }
+
+    Sequence<T>* Clone() const override {
+        int size = this->GetLength();
+        T* newData = new T[size];
+        int i = 0;
+        for (const T& value : *this->items) newData[i++] = value;
+        auto* result = new ImmutableListSequence<T>(newData, size);
+        delete[] newData;
+        return result;
+    }
+};
+
+// ------------------------- Mutable -------------------------
+
+template<typename T>
+class MutableListSequence : public ListSequence<T> {
+public:
+    MutableListSequence() : ListSequence<T>() {}
+    MutableListSequence(T* data, int count) : ListSequence<T>(data, count) {}
+    MutableListSequence(const MutableListSequence<T>& other) : ListSequence<T>(other) {}
+
+    Sequence<T>* CreateFromArray(T* data, int size) const override {
+        return new MutableListSequence<T>(data, size);
+    }
+
+    Sequence<T>* Instance() const override {
+        return new MutableListSequence<T>();
+    }
+
+    Sequence<T>* Clone() const override {
+        return new MutableListSequence<T>(*this);
+    }
+
+    // Изменяемая версия меняет саму себя и возвращает this, как
+    // MutableArraySequence и MutableUnrolledListSequence. Узлы не переезжают,
+    // но вставка не в конец сдвигает индексы элементов за ней — курсоры,
+    // привязанные к позиции, устаревают.
+    Sequence<T>* Append(T item) override {
+        this->items->Append(item);
+        return this;
+    }
+
+    Sequence<T>* Prepend(T item) override {
+        this->items->Prepend(item);
+        ++this->layoutVersion;
+        return this;
+    }
+
+    Sequence<T>* InsertAt(int index, T item) override {
+        bool atEnd = index == this->GetLength();
+        this->items->InsertAt(index, item);
+        if (!atEnd) ++this->layoutVersion;
+        return this;
+    }
+};
+
+#endif
@@ -0,0 +1,204 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Аллокаторы узлов для LinkedList. Интерфейс:
+//   void* Allocate();              — память под один узел (без конструирования)
+//   void  Deallocate(void* p);     — вернуть память одного узла
+//   void  Release();               — освободить всё разом
+//   static constexpr bool kBulkRelease — true, если Release() сам отдаёт память
+//                                        всех узлов (поштучный Deallocate не нужен)
+//   static constexpr int kInlineNodes  — сколько узлов живёт внутри самого аллокатора;
+//                                        если > 0, нужны ещё InlineIndex/InlineSlot/
+//                                        AdoptInline (см. NodePool)
+
+// Пул по умолчанию: узлы нарезаются из блоков (slab), размер блока растёт
+// геометрически — 2, 4, 8, ... до kMaxBlock узлов, так что короткие списки
+// (соседи вершины графа) почти не тратят лишнего, а длинные делают O(log n)
+// обращений к куче вместо n. Поштучно освобождённые узлы уходят во free-list.
+// Release() возвращает память за O(#блоков). Пул живёт в каждом списке, а списков
+// в графе столько же, сколько вершин, поэтому его состояние — три указателя и
+// малый буфер.
+//
+// Малый буфер: первые kInlineNodes узлов (32 байта — два узла LinkedList<int>)
+// выдаются из ячеек внутри самого пула, и список из пары соседей вообще
+// не обращается к кучу. Такие узлы нельзя «украсть» перемещением пула —
+// их переносит владелец списка через InlineIndex/InlineSlot/AdoptInline.
+template<typename Node>
+class NodePool {
+    union Slot;
+
+public:
+    static constexpr bool kBulkRelease = true;
+    static constexpr int kInlineBytes = 32;
+
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept { steal(other); }
+
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            Release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~NodePool() { Release(); }
+
+    void* Allocate() {
+        if (freeList) {
+            Slot* s = freeList;
+            freeList = s->next;
+            return s;
+        }
+        if (!blocks) {
+            if (inlineUsed < kInlineNodes) return inlineSlot(inlineUsed++);
+            addBlock();
+        } else if (cursor == blocks + 1 + blocks->header.capacity) {
+            addBlock();
+        }
+        return cursor++;
+    }
+
+    // Встроенные ячейки не переиспользуются поштучно (во free-list попали бы
+    // адреса внутри объекта, которые не переживут перемещение), а ждут Release().
+    void Deallocate(void* p) noexcept {
+        if (InlineIndex(p) >= 0) return;
+        Slot* s = static_cast<Slot*>(p);
+        s->next = freeList;
+        freeList = s;
+    }
+
+    void Release() noexcept {
+        while (blocks) {
+            Slot* prev = blocks->header.prev;
+            freeBlock(blocks);
+            blocks = prev;
+        }
+        cursor = freeList = nullptr;
+        inlineUsed = 0;
+    }
+
+    // Номер встроенной ячейки, в которой лежит p, или -1, если p — из кучи.
+    int InlineIndex(const void* p) const noexcept {
+        for (int i = 0; i < kInlineNodes; i++)
+            if (p == inlineSlot(i)) return i;
+        return -1;
+    }
+
+    void* InlineSlot(int index) noexcept { return inlineSlot(index); }
+    int InlineInUse() const noexcept { return inlineUsed; }
+
+    // Перемещение пула забирает только блоки из кучи. Владелец, перенеся узлы
+    // из встроенного буфера исходного пула в наш (на те же номера ячеек),
+    // отмечает первые count ячеек занятыми.
+    void AdoptInline(int count) noexcept { inlineUsed = count; }
+
+private:
+    struct BlockHeader {
+        Slot* prev;     // предыдущий блок
+        int capacity;   // число ячеек под узлы (без заголовка)
+    };
+
+    // Ячейка блока: живой узел, звено free-list или (нулевая ячейка) заголовок блока.
+    union Slot {
+        Slot* next;
+        BlockHeader header;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+public:
+    static constexpr int kInlineNodes = static_cast<int>(kInlineBytes / sizeof(Slot));
+
+private:
+    // Встроенный буфер уже покрыл самые короткие списки, первый блок из кучи крупнее.
+    static constexpr int kMinBlock = 4;
+    static constexpr int kMaxBlock = 1024;
+
+    Slot* blocks = nullptr;     // последний выделенный блок
+    Slot* cursor = nullptr;     // первая ещё не выданная ячейка последнего блока
+    Slot* freeList = nullptr;
+    int inlineUsed = 0;         // выдано встроенных ячеек (они выдаются первыми)
+
+    // Узел крупнее kInlineBytes встроенных ячеек не получает: тогда буфер —
+    // пустой тип и за счёт [[no_unique_address]] не увеличивает пул.
+    template<int N, typename = void>
+    struct InlineBuffer {
+        Slot slots[N];
+    };
+    template<typename Unused>
+    struct InlineBuffer<0, Unused> {};
+
+    [[no_unique_address]] InlineBuffer<kInlineNodes> inlineBuffer;
+
+    Slot* inlineSlot(int index) noexcept {
+        if constexpr (kInlineNodes > 0) {
+            return inlineBuffer.slots + index;
+        } else {
+            (void)index;
+            return nullptr;
+        }
+    }
+    const Slot* inlineSlot(int index) const noexcept {
+        if constexpr (kInlineNodes > 0) {
+            return inlineBuffer.slots + index;
+        } else {
+            (void)index;
+            return nullptr;
+        }
+    }
+
+    // Выровненный operator new заметно дороже по памяти, поэтому зовём его
+    // только для узлов с выравниванием больше стандартного.
+    static constexpr bool kOverAligned = alignof(Slot) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    static Slot* allocBlock(std::size_t count) {
+        if constexpr (kOverAligned)
+            return static_cast<Slot*>(::operator new(sizeof(Slot) * count, std::align_val_t(alignof(Slot))));
+        else
+            return static_cast<Slot*>(::operator new(sizeof(Slot) * count));
+    }
+
+    static void freeBlock(Slot* block) noexcept {
+        if constexpr (kOverAligned)
+            ::operator delete(block, std::align_val_t(alignof(Slot)));
+        else
+            ::operator delete(block);
+    }
+
+    void addBlock() {
+        int capacity = kMinBlock;
+        if (blocks) capacity = blocks->header.capacity < kMaxBlock ? blocks->header.capacity * 2 : kMaxBlock;
+        std::size_t count = static_cast<std::size_t>(capacity) + 1;
+        Slot* block = allocBlock(count);
+        block->header.prev = blocks;
+        block->header.capacity = capacity;
+        blocks = block;
+        cursor = block + 1;
+    }
+
+    void steal(NodePool& other) noexcept {
+        blocks = std::exchange(other.blocks, nullptr);
+        cursor = std::exchange(other.cursor, nullptr);
+        freeList = std::exchange(other.freeList, nullptr);
+        inlineUsed = 0;
+        other.inlineUsed = 0;
+    }
+};
+
+// Каждый узел — отдельное обращение к куче (прежнее поведение LinkedList).
+template<typename Node>
+class HeapNodeAllocator {
+public:
+    static constexpr bool kBulkRelease = false;
+    static constexpr int kInlineNodes = 0;
+
+    void* Allocate() { return ::operator new(sizeof(Node)); }
+    void Deallocate(void* p) noexcept { ::operator delete(p); }
+
+    void Release() noexcept {}
+};
@@ -0,0 +1,35 @@
+#ifndef PROCESS_MEMORY_H
+#define PROCESS_MEMORY_H
+
+#include <cstdio>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+// Текущий резидентный объём памяти процесса (RSS) в килобайтах; 0, если платформа не поддержана.
+// В отличие от счётчиков AllocTracking.h, видит всю память процесса, а не только operator new.
+inline long long CurrentRssKB() {
+#if defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+    return static_cast<long long>(info.resident_size / 1024);
+#elif defined(__linux__)
+    long long pages = 0, resident = 0;
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    int read = std::fscanf(f, "%lld %lld", &pages, &resident);
+    std::fclose(f);
+    if (read != 2) return 0;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return 0;
+#endif
+}
+
+#endif
@@ -0,0 +1,549 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include "sequence.h"
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Развёрнутый (unrolled) связный список: в каждом узле — небольшой массив
+// элементов (~64 байта полезной нагрузки). Указатель next приходится на
+// целый блок, а не на каждый элемент, обход идёт подряд по памяти узла,
+// а поиск по индексу перескакивает узлы целиком.
+template<typename T>
+class UnrolledList {
+public:
+    static constexpr int kNodeCapacity =
+        sizeof(T) * 4 >= 64 ? 4 : static_cast<int>(64 / sizeof(T));
+
+private:
+    struct Node {
+        Node* next;
+        int count;
+        alignas(T) unsigned char storage[sizeof(T) * kNodeCapacity];
+
+        Node() : next(nullptr), count(0) {}
+        T* items() { return reinterpret_cast<T*>(storage); }
+        const T* items() const { return reinterpret_cast<const T*>(storage); }
+    };
+
+    Node* head;
+    Node* tail;
+    int size;
+
+    void Clear();
+    // Узел с первым элементом item; связывание — забота вызывающего.
+    static Node* makeNode(const T& item);
+    // Узел и позиция в нём для index < size.
+    Node* locate(int index, int& pos) const;
+    // Вставка в узел, где есть свободное место: сдвиг хвоста узла вправо.
+    static void insertIntoNode(Node* node, int pos, T&& item);
+
+public:
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() : node(nullptr), pos(0) {}
+        ConstIterator(const Node* n, int p) : node(n), pos(p) {}
+
+        reference operator*() const { return node->items()[pos]; }
+        pointer operator->() const { return node->items() + pos; }
+        ConstIterator& operator++() {
+            if (++pos == node->count) { node = node->next; pos = 0; }
+            return *this;
+        }
+        ConstIterator operator++(int) { ConstIterator tmp = *this; ++(*this); return tmp; }
+        bool operator==(const ConstIterator& other) const { return node == other.node && pos == other.pos; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+
+    private:
+        const Node* node;
+        int pos;
+    };
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() : node(nullptr), pos(0) {}
+        Iterator(Node* n, int p) : node(n), pos(p) {}
+
+        reference operator*() const { return node->items()[pos]; }
+        pointer operator->() const { return node->items() + pos; }
+        Iterator& operator++() {
+            if (++pos == node->count) { node = node->next; pos = 0; }
+            return *this;
+        }
+        Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+        bool operator==(const Iterator& other) const { return node == other.node && pos == other.pos; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+        operator ConstIterator() const { return ConstIterator(node, pos); }
+
+    private:
+        Node* node;
+        int pos;
+    };
+
+    UnrolledList();
+    UnrolledList(T* items, int count);
+    UnrolledList(const UnrolledList<T>& other);
+    UnrolledList(UnrolledList<T>&& other) noexcept;
+    UnrolledList<T>& operator=(const UnrolledList<T>& other);
+    UnrolledList<T>& operator=(UnrolledList<T>&& other) noexcept;
+    ~UnrolledList();
+
+    T Get(int index) const;
+    void Append(const T& item);
+    void Prepend(const T& item);
+    void InsertAt(int index, const T& item);
+    int GetLength() const;
+
+    T GetFirst() const;
+    T GetLast() const;
+
+    // Итератор на элемент index (index == GetLength() — end()); O(index / kNodeCapacity).
+    ConstIterator IteratorAt(int index) const;
+
+    Iterator begin() { return Iterator(head, 0); }
+    Iterator end() { return Iterator(nullptr, 0); }
+    ConstIterator begin() const { return ConstIterator(head, 0); }
+    ConstIterator end() const { return ConstIterator(nullptr, 0); }
+};
+
+// ------------------------- служебное -------------------------
+
+template<typename T>
+void UnrolledList<T>::Clear() {
+    Node* cur = head;
+    while (cur) {
+        Node* next = cur->next;
+        for (int i = 0; i < cur->count; i++) cur->items()[i].~T();
+        delete cur;
+        cur = next;
+    }
+    head = tail = nullptr;
+    size = 0;
+}
+
+template<typename T>
+typename UnrolledList<T>::Node* UnrolledList<T>::makeNode(const T& item) {
+    Node* node = new Node();
+    try {
+        new (node->items()) T(item);
+    } catch (...) {
+        delete node;
+        throw;
+    }
+    node->count = 1;
+    return node;
+}
+
+template<typename T>
+typename UnrolledList<T>::Node* UnrolledList<T>::locate(int index, int& pos) const {
+    Node* cur = head;
+    while (index >= cur->count) {
+        index -= cur->count;
+        cur = cur->next;
+    }
+    pos = index;
+    return cur;
+}
+
+template<typename T>
+void UnrolledList<T>::insertIntoNode(Node* node, int pos, T&& item) {
+    T* a = node->items();
+    int count = node->count;
+    if (pos == count) {
+        new (a + count) T(std::move(item));
+    } else {
+        new (a + count) T(std::move(a[count - 1]));
+        for (int i = count - 1; i > pos; i--) a[i] = std::move(a[i - 1]);
+        a[pos] = std::move(item);
+    }
+    node->count++;
+}
+
+// ------------------------- конструкторы -------------------------
+
+template<typename T>
+UnrolledList<T>::UnrolledList() : head(nullptr), tail(nullptr), size(0) {}
+
+template<typename T>
+UnrolledList<T>::UnrolledList(T* items, int count) : UnrolledList() {
+    if (count < 0) throw std::invalid_argument("count < 0");
+    for (int i = 0; i < count; i++) Append(items[i]);
+}
+
+template<typename T>
+UnrolledList<T>::UnrolledList(const UnrolledList<T>& other) : UnrolledList() {
+    for (const T& value : other) Append(value);
+}
+
+template<typename T>
+UnrolledList<T>::UnrolledList(UnrolledList<T>&& other) noexcept
+    : head(other.head), tail(other.tail), size(other.size) {
+    other.head = other.tail = nullptr;
+    other.size = 0;
+}
+
+template<typename T>
+UnrolledList<T>& UnrolledList<T>::operator=(const UnrolledList<T>& other) {
+    if (this != &other) {
+        UnrolledList<T> copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template<typename T>
+UnrolledList<T>& UnrolledList<T>::operator=(UnrolledList<T>&& other) noexcept {
+    if (this != &other) {
+        Clear();
+        head = other.head;
+        tail = other.tail;
+        size = other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+template<typename T>
+UnrolledList<T>::~UnrolledList() {
+    Clear();
+}
+
+// ------------------------- доступ -------------------------
+
+template<typename T>
+int UnrolledList<T>::GetLength() const { return size; }
+
+template<typename T>
+T UnrolledList<T>::Get(int index) const {
+    if (index < 0 || index >= size)
+        throw std::out_of_range("Index out of range");
+    int pos;
+    Node* node = locate(index, pos);
+    return node->items()[pos];
+}
+
+template<typename T>
+T UnrolledList<T>::GetFirst() const {
+    if (!head) throw std::out_of_range("List is empty");
+    return head->items()[0];
+}
+
+template<typename T>
+T UnrolledList<T>::GetLast() const {
+    if (!tail) throw std::out_of_range("List is empty");
+    return tail->items()[tail->count - 1];
+}
+
+template<typename T>
+typename UnrolledList<T>::ConstIterator UnrolledList<T>::IteratorAt(int index) const {
+    if (index < 0 || index > size)
+        throw std::out_of_range("Index out of range");
+    if (index == size) return end();
+    int pos;
+    Node* node = locate(index, pos);
+    return ConstIterator(node, pos);
+}
+
+// ------------------------- изменение -------------------------
+
+// Хвостовой узел заполняется до конца, новый узел — только когда он полон.
+template<typename T>
+void UnrolledList<T>::Append(const T& item) {
+    if (tail && tail->count < kNodeCapacity) {
+        new (tail->items() + tail->count) T(item);
+        tail->count++;
+    } else {
+        Node* node = makeNode(item);
+        if (!tail) head = tail = node;
+        else {
+            tail->next = node;
+            tail = node;
+        }
+    }
+    size++;
+}
+
+template<typename T>
+void UnrolledList<T>::Prepend(const T& item) {
+    if (head && head->count < kNodeCapacity) {
+        insertIntoNode(head, 0, T(item));
+    } else {
+        Node* node = makeNode(item);
+        node->next = head;
+        head = node;
+        if (!tail) tail = head;
+    }
+    size++;
+}
+
+// Полный узел делится пополам: верхняя половина уходит в новый узел за ним.
+template<typename T>
+void UnrolledList<T>::InsertAt(int index, const T& item) {
+    if (index < 0 || index > size)
+        throw std::out_of_range("Index out of range");
+    if (index == size) return Append(item);
+    if (index == 0) return Prepend(item);
+
+    T value(item);
+    int pos;
+    Node* node = locate(index, pos);
+    if (node->count == kNodeCapacity) {
+        Node* right = new Node();
+        int half = kNodeCapacity / 2;
+        T* src = node->items();
+        T* dst = right->items();
+        for (int i = half; i < kNodeCapacity; i++) {
+            new (dst + (i - half)) T(std::move(src[i]));
+            src[i].~T();
+        }
+        right->count = kNodeCapacity - half;
+        node->count = half;
+        right->next = node->next;
+        node->next = right;
+        if (tail == node) tail = right;
+        if (pos > half) {
+            node = right;
+            pos -= half;
+        }
+    }
+    insertIntoNode(node, pos, std::move(value));
+    size++;
+}
+
+// ------------------------- UnrolledListSequence -------------------------
+
+template<typename T>
+class UnrolledListSequence : public Sequence<T> {
+protected:
+    UnrolledList<T>* items;
+    unsigned long long layoutVersion;     // см. Sequence::GetLayoutVersion
+
+    class UnrolledCursor;
+
+public:
+    UnrolledListSequence();
+    UnrolledListSequence(T* data, int count);
+    UnrolledListSequence(const UnrolledListSequence<T>& other);
+    virtual ~UnrolledListSequence();
+
+    T Get(int index) const override;
+    int GetLength() const override;
+    T GetFirst() const override;
+    T GetLast() const override;
+
+    Sequence<T>* Append(T item) override;
+    Sequence<T>* Prepend(T item) override;
+    Sequence<T>* InsertAt(int index, T item) override;
+    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override;
+    Sequence<T>* Concat(const Sequence<T>& other) const override;
+
+    virtual Sequence<T>* CreateFromArray(T* data, int size) const = 0;
+    virtual Sequence<T>* Instance() const = 0;
+    virtual Sequence<T>* Clone() const = 0;
+
+    std::unique_ptr<typename Sequence<T>::Cursor> CreateCursor(int startIndex = 0) const override;
+    void ForEach(const std::function<void(const T&)>& action) const override;
+    unsigned long long GetLayoutVersion() const override { return layoutVersion; }
+
+    typename UnrolledList<T>::ConstIterator begin() const { return items->begin(); }
+    typename UnrolledList<T>::ConstIterator end() const { return items->end(); }
+};
+
+template<typename T>
+class UnrolledListSequence<T>::UnrolledCursor : public Sequence<T>::Cursor {
+public:
+    explicit UnrolledCursor(typename UnrolledList<T>::ConstIterator start) : cur(start) {}
+    bool IsValid() const override { return cur != typename UnrolledList<T>::ConstIterator(); }
+    T Current() const override { return *cur; }
+    void Next() override { ++cur; }
+    typename Sequence<T>::Cursor* Clone() const override { return new UnrolledCursor(*this); }
+private:
+    typename UnrolledList<T>::ConstIterator cur;
+};
+
+template<typename T>
+UnrolledListSequence<T>::UnrolledListSequence() : items(new UnrolledList<T>()), layoutVersion(0) {}
+
+template<typename T>
+UnrolledListSequence<T>::UnrolledListSequence(T* data, int count)
+    : items(new UnrolledList<T>(data, count)), layoutVersion(0) {}
+
+template<typename T>
+UnrolledListSequence<T>::UnrolledListSequence(const UnrolledListSequence<T>& other)
+    : items(new UnrolledList<T>(*other.items)), layoutVersion(0) {}
+
+template<typename T>
+UnrolledListSequence<T>::~UnrolledListSequence() { delete items; }
+
+template<typename T>
+T UnrolledListSequence<T>::Get(int index) const { return items->Get(index); }
+
+template<typename T>
+int UnrolledListSequence<T>::GetLength() const { return items->GetLength(); }
+
+template<typename T>
+T UnrolledListSequence<T>::GetFirst() const { return items->GetFirst(); }
+
+template<typename T>
+T UnrolledListSequence<T>::GetLast() const { return items->GetLast(); }
+
+template<typename T>
+std::unique_ptr<typename Sequence<T>::Cursor> UnrolledListSequence<T>::CreateCursor(int startIndex) const {
+    return std::make_unique<UnrolledCursor>(items->IteratorAt(startIndex));
+}
+
+template<typename T>
+void UnrolledListSequence<T>::ForEach(const std::function<void(const T&)>& action) const {
+    for (const T& value : *items) {
+        action(value);
+    }
+}
+
+template<typename T>
+Sequence<T>* UnrolledListSequence<T>::Append(T item) {
+    int size = GetLength();
+    T* newData = new T[size + 1];
+    int i = 0;
+    for (const T& value : *items) newData[i++] = value;
+    newData[size] = item;
+    auto* result = CreateFromArray(newData, size + 1);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* UnrolledListSequence<T>::Prepend(T item) {
+    int size = GetLength();
+    T* newData = new T[size + 1];
+    newData[0] = item;
+    int i = 1;
+    for (const T& value : *items) newData[i++] = value;
+    auto* result = CreateFromArray(newData, size + 1);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* UnrolledListSequence<T>::InsertAt(int index, T item) {
+    int size = GetLength();
+    if (index < 0 || index > size)
+        throw std::out_of_range("Index out of range");
+    T* newData = new T[size + 1];
+    int i = 0;
+    for (const T& value : *items) {
+        if (i == index) newData[i++] = item;
+        newData[i++] = value;
+    }
+    if (index == size) newData[size] = item;
+    auto* result = CreateFromArray(newData, size + 1);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* UnrolledListSequence<T>::GetSubsequence(int startIndex, int endIndex) const {
+    if (startIndex < 0 || endIndex >= GetLength() || startIndex > endIndex)
+        throw std::out_of_range("Index out of range");
+    int size = endIndex - startIndex + 1;
+    T* newData = new T[size];
+    auto it = items->IteratorAt(startIndex);
+    for (int i = 0; i < size; i++, ++it) newData[i] = *it;
+    auto* result = CreateFromArray(newData, size);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* UnrolledListSequence<T>::Concat(const Sequence<T>& other) const {
+    int size = GetLength() + other.GetLength();
+    T* newData = new T[size];
+    int i = 0;
+    for (const T& value : *items) newData[i++] = value;
+    other.ForEach([&](const T& value) { newData[i++] = value; });
+    auto* result = CreateFromArray(newData, size);
+    delete[] newData;
+    return result;
+}
+
+// ------------------------- Immutable -------------------------
+
+template<typename T>
+class ImmutableUnrolledListSequence : public UnrolledListSequence<T> {
+public:
+    ImmutableUnrolledListSequence() : UnrolledListSequence<T>() {}
+    ImmutableUnrolledListSequence(T* data, int count) : UnrolledListSequence<T>(data, count) {}
+    ImmutableUnrolledListSequence(const ImmutableUnrolledListSequence<T>& other) : UnrolledListSequence<T>(other) {}
+
+    Sequence<T>* CreateFromArray(T* data, int size) const override {
+        return new ImmutableUnrolledListSequence<T>(data, size);
+    }
+
+    Sequence<T>* Instance() const override {
+        return new ImmutableUnrolledListSequence<T>();
+    }
+
+    Sequence<T>* Clone() const override {
+        return new ImmutableUnrolledListSequence<T>(*this);
+    }
+};
+
+// ------------------------- Mutable -------------------------
+
+template<typename T>
+class MutableUnrolledListSequence : public UnrolledListSequence<T> {
+public:
+    MutableUnrolledListSequence() : UnrolledListSequence<T>() {}
+    MutableUnrolledListSequence(T* data, int count) : UnrolledListSequence<T>(data, count) {}
+    MutableUnrolledListSequence(const MutableUnrolledListSequence<T>& other) : UnrolledListSequence<T>(other) {}
+
+    Sequence<T>* CreateFromArray(T* data, int size) const override {
+        return new MutableUnrolledListSequence<T>(data, size);
+    }
+
+    Sequence<T>* Instance() const override {
+        return new MutableUnrolledListSequence<T>();
+    }
+
+    Sequence<T>* Clone() const override {
+        return new MutableUnrolledListSequence<T>(*this);
+    }
+
+    // Изменяемая версия меняет саму себя и возвращает this. Append курсоры
+    // не сдвигает; вставка в начало или середину сдвигает элементы в узле
+    // (или делит узел) — курсоры устаревают.
+    Sequence<T>* Append(T item) override {
+        this->items->Append(item);
+        return this;
+    }
+
+    Sequence<T>* Prepend(T item) override {
+        this->items->Prepend(item);
+        ++this->layoutVersion;
+        return this;
+    }
+
+    Sequence<T>* InsertAt(int index, T item) override {
+        bool atEnd = index == this->GetLength();
+        this->items->InsertAt(index, item);
+        if (!atEnd) ++this->layoutVersion;
+        return this;
+    }
+};
+
+#endif
@@ -0,0 +1,395 @@
+#ifndef DYNAMIC_ARRAY_H
+#define DYNAMIC_ARRAY_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cassert>
+#include <new>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+// Хранилище — «сырая» память на capacity ячеек, из которых живы только первые size:
+// объекты создаются placement-new и разрушаются явно, поэтому резерв ёмкости
+// не вызывает конструкторов T. Для тривиально копируемых T перенос и копирование
+// делаются через memcpy/memmove.
+//
+// Малый буфер: для тривиально копируемых T первые kInlineBytes байт элементов
+// (16 char, 4 int, 2 double) живут прямо в объекте, и куча не нужна, пока массив
+// в них помещается. data указывает либо во встроенный буфер, либо в кучу.
+template<typename T>
+class DynamicArray {
+public:
+    static constexpr int kInlineBytes = 16;
+
+private:
+    static constexpr bool trivial = std::is_trivially_copyable_v<T>;
+    static constexpr int kInlineCapacity =
+        trivial && sizeof(T) <= kInlineBytes ? static_cast<int>(kInlineBytes / sizeof(T)) : 0;
+
+    template<int N, typename Dummy = void>
+    struct InlineBuffer {
+        alignas(T) unsigned char bytes[sizeof(T) * N];
+        T* get() { return reinterpret_cast<T*>(bytes); }
+        const T* get() const { return reinterpret_cast<const T*>(bytes); }
+    };
+    template<typename Dummy>
+    struct InlineBuffer<0, Dummy> {
+        T* get() { return nullptr; }
+        const T* get() const { return nullptr; }
+    };
+
+    T* data;
+    int size;
+    int capacity;   // выделено ячеек; size <= capacity
+    [[no_unique_address]] InlineBuffer<kInlineCapacity> small;
+
+    static T* allocate(int count);
+    static void deallocate(T* ptr);
+    static void destroy(T* first, int count);
+    static void relocate(T* dst, T* src, int count);
+
+    bool isInline() const { return kInlineCapacity > 0 && data == small.get(); }
+    // Буфер на count ячеек: встроенный, если хватает, иначе из кучи.
+    void acquire(int count);
+    void release();
+    // Пустой массив на встроенном буфере (состояние после перемещения).
+    void resetToInline();
+    void takeFrom(DynamicArray<T>& other) noexcept;
+
+    void grow(int minCapacity);
+public:
+    DynamicArray(T* items, int count);
+    DynamicArray(int size);
+    DynamicArray(const DynamicArray<T>& other);
+    DynamicArray(DynamicArray<T>&& other) noexcept;
+    DynamicArray<T>& operator=(const DynamicArray<T>& other);
+    DynamicArray<T>& operator=(DynamicArray<T>&& other) noexcept;
+    ~DynamicArray();
+
+    T Get(int index) const;
+    int GetSize() const;
+    int GetCapacity() const;
+    void Set(int index, T value);
+    void Resize(int newSize);
+    void Reserve(int newCapacity);
+    void PushBack(const T& value);
+    void PushBack(T&& value);
+    template<typename... Args>
+    T& EmplaceBack(Args&&... args);
+    void Insert(int index, const T& value);
+    void Print() const;
+
+    // Быстрый доступ по ссылке без проверки границ в Release:
+    // выход за границы ловит assert только в отладочной сборке (без NDEBUG).
+    // Get/Set остаются проверяемыми и бросают std::out_of_range.
+    T& operator[](int index);
+    const T& operator[](int index) const;
+    T& UncheckedGet(int index);
+    const T& UncheckedGet(int index) const;
+
+    // Итераторы произвольного доступа (непрерывный буфер)
+    T* begin() { return data; }
+    T* end() { return data + size; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+};
+
+
+// ------------------------- работа с сырой памятью -------------------------
+
+template<typename T>
+T* DynamicArray<T>::allocate(int count) {
+    if (count == 0) return nullptr;
+    return static_cast<T*>(::operator new(sizeof(T) * static_cast<std::size_t>(count),
+                                          std::align_val_t(alignof(T))));
+}
+
+template<typename T>
+void DynamicArray<T>::deallocate(T* ptr) {
+    if (ptr) ::operator delete(ptr, std::align_val_t(alignof(T)));
+}
+
+template<typename T>
+void DynamicArray<T>::destroy(T* first, int count) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (int i = 0; i < count; i++) first[i].~T();
+    }
+}
+
+// Переносит count живых объектов из src в неинициализированную память dst.
+template<typename T>
+void DynamicArray<T>::relocate(T* dst, T* src, int count) {
+    if constexpr (trivial) {
+        if (count > 0) std::memcpy(static_cast<void*>(dst), src, sizeof(T) * count);
+    } else {
+        for (int i = 0; i < count; i++) {
+            new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+template<typename T>
+void DynamicArray<T>::acquire(int count) {
+    if (count <= kInlineCapacity) {
+        data = small.get();
+        capacity = kInlineCapacity;
+    } else {
+        data = allocate(count);
+        capacity = count;
+    }
+}
+
+template<typename T>
+void DynamicArray<T>::release() {
+    if (!isInline()) deallocate(data);
+}
+
+template<typename T>
+void DynamicArray<T>::resetToInline() {
+    data = small.get();
+    size = 0;
+    capacity = kInlineCapacity;
+}
+
+// Забирает содержимое other: буфер из кучи — перекладыванием указателя,
+// встроенный (только тривиальные T) — копированием байтов.
+template<typename T>
+void DynamicArray<T>::takeFrom(DynamicArray<T>& other) noexcept {
+    if (other.isInline()) {
+        data = small.get();
+        capacity = kInlineCapacity;
+        relocate(data, other.data, other.size);
+    } else {
+        data = other.data;
+        capacity = other.capacity;
+    }
+    size = other.size;
+    other.resetToInline();
+}
+
+// ------------------------- конструкторы -------------------------
+
+template<typename T>
+DynamicArray<T>::DynamicArray(T* items, int count) : data(nullptr), size(0), capacity(0) {
+    if (count < 0)
+        throw std::invalid_argument("size cannot be negative");
+    acquire(count);
+    if constexpr (trivial) {
+        if (count > 0) std::memcpy(static_cast<void*>(data), items, sizeof(T) * count);
+        size = count;
+    } else {
+        try {
+            for (; size < count; size++) new (data + size) T(items[size]);
+        } catch (...) {
+            destroy(data, size);
+            release();
+            throw;
+        }
+    }
+}
+
+template<typename T>
+DynamicArray<T>::DynamicArray(int size) : data(nullptr), size(0), capacity(0) {
+    if (size < 0)
+        throw std::invalid_argument("size cannot be negative");
+    acquire(size);
+    try {
+        for (; this->size < size; this->size++) new (data + this->size) T();
+    } catch (...) {
+        destroy(data, this->size);
+        release();
+        throw;
+    }
+}
+
+template<typename T>
+DynamicArray<T>::DynamicArray(const DynamicArray<T>& other)
+    : DynamicArray(other.data, other.size) {}
+
+template<typename T>
+DynamicArray<T>::DynamicArray(DynamicArray<T>&& other) noexcept {
+    takeFrom(other);
+}
+
+template<typename T>
+DynamicArray<T>& DynamicArray<T>::operator=(const DynamicArray<T>& other) {
+    if (this == &other) return *this;
+    DynamicArray<T> copy(other);
+    *this = std::move(copy);
+    return *this;
+}
+
+template<typename T>
+DynamicArray<T>& DynamicArray<T>::operator=(DynamicArray<T>&& other) noexcept {
+    if (this == &other) return *this;
+    destroy(data, size);
+    release();
+    takeFrom(other);
+    return *this;
+}
+
+template<typename T>
+DynamicArray<T>::~DynamicArray() {
+    destroy(data, size);
+    release();
+}
+
+// ------------------------- доступ -------------------------
+
+template<typename T>
+T DynamicArray<T>::Get(int index) const {
+    if (index < 0 || index >= size)
+        throw std::out_of_range("Index out of range");
+    return data[index];
+}
+
+template<typename T>
+int DynamicArray<T>::GetSize() const {
+    return size;
+}
+
+template<typename T>
+int DynamicArray<T>::GetCapacity() const {
+    return capacity;
+}
+
+template<typename T>
+void DynamicArray<T>::Set(int index, T value) {
+    if (index < 0 || index >= size)
+        throw std::out_of_range("Index out of range");
+    data[index] = std::move(value);
+}
+
+// ------------------------- ёмкость и размер -------------------------
+
+// Переносит элементы в буфер ровно на newCapacity ячеек (newCapacity >= size).
+template<typename T>
+void DynamicArray<T>::Reserve(int newCapacity) {
+    if (newCapacity <= capacity) return;
+
+    T* newData = allocate(newCapacity);
+    relocate(newData, data, size);
+
+    release();
+    data = newData;
+    capacity = newCapacity;
+}
+
+// Геометрический рост (x2): серия PushBack обходится в O(1) амортизированно.
+template<typename T>
+void DynamicArray<T>::grow(int minCapacity) {
+    int newCapacity = capacity < 4 ? 4 : capacity * 2;
+    if (newCapacity < minCapacity) newCapacity = minCapacity;
+    Reserve(newCapacity);
+}
+
+template<typename T>
+void DynamicArray<T>::Resize(int newSize) {
+    if (newSize < 0)
+        throw std::invalid_argument("new size cannot be negative");
+
+    if (newSize < size) {
+        destroy(data + newSize, size - newSize);
+        size = newSize;
+        return;
+    }
+    if (newSize > capacity) {
+        Reserve(newSize);
+    }
+    for (; size < newSize; size++) {
+        new (data + size) T();
+    }
+}
+
+template<typename T>
+void DynamicArray<T>::PushBack(const T& value) {
+    EmplaceBack(value);
+}
+
+template<typename T>
+void DynamicArray<T>::PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+}
+
+template<typename T>
+template<typename... Args>
+T& DynamicArray<T>::EmplaceBack(Args&&... args) {
+    if (size == capacity) {
+        // аргументы могут ссылаться на элемент этого же массива —
+        // строим объект в новом буфере до переноса старых элементов
+        int newCapacity = capacity < 4 ? 4 : capacity * 2;
+        T* newData = allocate(newCapacity);
+        try {
+            new (newData + size) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(newData);
+            throw;
+        }
+        relocate(newData, data, size);
+        release();
+        data = newData;
+        capacity = newCapacity;
+    } else {
+        new (data + size) T(std::forward<Args>(args)...);
+    }
+    return data[size++];
+}
+
+template<typename T>
+void DynamicArray<T>::Insert(int index, const T& value) {
+    if (index < 0 || index > size)
+        throw std::out_of_range("Index out of range");
+    if (index == size) {
+        EmplaceBack(value);
+        return;
+    }
+    T copy = value;
+    if (size == capacity) {
+        grow(size + 1);
+    }
+    if constexpr (trivial) {
+        std::memmove(static_cast<void*>(data + index + 1), data + index, sizeof(T) * (size - index));
+        new (data + index) T(std::move(copy));
+    } else {
+        new (data + size) T(std::move(data[size - 1]));
+        for (int i = size - 1; i > index; i--) {
+            data[i] = std::move(data[i - 1]);
+        }
+        data[index] = std::move(copy);
+    }
+    size++;
+}
+
+template<typename T>
+void DynamicArray<T>::Print() const {
+    for (int i = 0; i < size; i++) {
+        std::cout << data[i] << " ";
+    }
+    std::cout << std::endl;
+}
+
+template<typename T>
+T& DynamicArray<T>::operator[](int index) {
+    assert(index >= 0 && index < size && "DynamicArray index out of range");
+    return data[index];
+}
+
+template<typename T>
+const T& DynamicArray<T>::operator[](int index) const {
+    assert(index >= 0 && index < size && "DynamicArray index out of range");
+    return data[index];
+}
+
+template<typename T>
+T& DynamicArray<T>::UncheckedGet(int index) {
+    return (*this)[index];
+}
+
+template<typename T>
+const T& DynamicArray<T>::UncheckedGet(int index) const {
+    return (*this)[index];
+}
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+
+#include "dynamic_array.h"
+#include <stdexcept>
+#include <memory>
+#include <utility>
+
+// Персистентный вектор: 32-ичное префиксное дерево плюс «хвостовой» лист.
+// Каждая версия — лёгкий дескриптор (размер, глубина, корень, хвост); изменение
+// копирует только путь от корня до листа (O(log32 n) узлов), остальное дерево
+// разделяется со старой версией. Узлы неизменяемы и живут, пока на них ссылается
+// хотя бы одна версия (std::shared_ptr).
+//
+// Последние 1..32 элемента лежат в хвосте, а не в дереве, поэтому PushBack
+// в среднем копирует лишь хвост и опускает его в дерево раз в 32 вставки.
+template<typename T>
+class PersistentVector {
+public:
+    static constexpr int kBits = 5;
+    static constexpr int kWidth = 1 << kBits;
+    static constexpr int kMask = kWidth - 1;
+
+    PersistentVector();
+    PersistentVector(const T* items, int count);
+
+    int GetSize() const;
+    const T& Get(int index) const;
+
+    PersistentVector<T> PushBack(const T& value) const;
+    PersistentVector<T> Set(int index, const T& value) const;
+
+    // Указатель на элемент index и число элементов, лежащих подряд начиная с него
+    // (до конца листа) — для последовательного обхода без спуска по дереву на каждом шаге.
+    const T* ChunkAt(int index, int& available) const;
+
+    template<typename Fn>
+    void ForEach(Fn&& action) const;
+
+private:
+    struct Node {};
+    struct Branch : Node {
+        std::shared_ptr<const Node> child[kWidth];
+    };
+    struct Leaf : Node {
+        T values[kWidth];
+    };
+    using NodePtr = std::shared_ptr<const Node>;
+
+    int size;
+    int shift;                          // уровень корня: kBits * (глубина дерева)
+    NodePtr root;                       // nullptr, пока все элементы в хвосте
+    std::shared_ptr<const Leaf> tail;   // nullptr для пустого вектора
+
+    int tailOffset() const;
+    const Leaf* leafFor(int index) const;
+
+    static const Branch* asBranch(const Node* node) { return static_cast<const Branch*>(node); }
+    static const Leaf* asLeaf(const Node* node) { return static_cast<const Leaf*>(node); }
+
+    NodePtr pushTail(int level, const Node* parent, NodePtr tailNode) const;
+    static NodePtr newPath(int level, NodePtr node);
+    static NodePtr doSet(int level, const Node* node, int index, const T& value);
+};
+
+// ------------------------- конструкторы -------------------------
+
+template<typename T>
+PersistentVector<T>::PersistentVector() : size(0), shift(kBits), root(nullptr), tail(nullptr) {}
+
+// Пакетная сборка снизу вверх: полные листы группируются по 32 в узлы,
+// пока не останется один корень. Выходит то же дерево, что и после count вызовов PushBack.
+template<typename T>
+PersistentVector<T>::PersistentVector(const T* items, int count) : PersistentVector() {
+    if (count < 0)
+        throw std::invalid_argument("size cannot be negative");
+    if (count == 0) return;
+
+    size = count;
+    int offset = tailOffset();
+
+    auto last = std::make_shared<Leaf>();
+    for (int i = offset; i < count; i++) last->values[i - offset] = items[i];
+    tail = std::move(last);
+
+    if (offset == 0) return;
+
+    DynamicArray<NodePtr> level(0);
+    level.Reserve(offset / kWidth);
+    for (int start = 0; start < offset; start += kWidth) {
+        auto leaf = std::make_shared<Leaf>();
+        for (int i = 0; i < kWidth; i++) leaf->values[i] = items[start + i];
+        level.PushBack(std::move(leaf));
+    }
+
+    for (;;) {
+        DynamicArray<NodePtr> parents(0);
+        parents.Reserve((level.GetSize() + kMask) / kWidth);
+        for (int start = 0; start < level.GetSize(); start += kWidth) {
+            auto branch = std::make_shared<Branch>();
+            for (int i = start; i < level.GetSize() && i < start + kWidth; i++)
+                branch->child[i - start] = std::move(level[i]);
+            parents.PushBack(std::move(branch));
+        }
+        level = std::move(parents);
+        if (level.GetSize() == 1) break;
+        shift += kBits;
+    }
+    root = std::move(level[0]);
+}
+
+// ------------------------- доступ -------------------------
+
+template<typename T>
+int PersistentVector<T>::GetSize() const {
+    return size;
+}
+
+template<typename T>
+int PersistentVector<T>::tailOffset() const {
+    return size < kWidth ? 0 : ((size - 1) >> kBits) << kBits;
+}
+
+template<typename T>
+const typename PersistentVector<T>::Leaf* PersistentVector<T>::leafFor(int index) const {
+    if (index >= tailOffset()) return tail.get();
+    const Node* node = root.get();
+    for (int level = shift; level > 0; level -= kBits)
+        node = asBranch(node)->child[(index >> level) & kMask].get();
+    return asLeaf(node);
+}
+
+template<typename T>
+const T& PersistentVector<T>::Get(int index) const {
+    if (index < 0 || index >= size)
+        throw std::out_of_range("Index out of range");
+    return leafFor(index)->values[index & kMask];
+}
+
+template<typename T>
+const T* PersistentVector<T>::ChunkAt(int index, int& available) const {
+    if (index < 0 || index >= size)
+        throw std::out_of_range("Index out of range");
+    int leafEnd = index >= tailOffset() ? size : (index | kMask) + 1;
+    available = leafEnd - index;
+    return leafFor(index)->values + (index & kMask);
+}
+
+template<typename T>
+template<typename Fn>
+void PersistentVector<T>::ForEach(Fn&& action) const {
+    int index = 0;
+    while (index < size) {
+        int available = 0;
+        const T* chunk = ChunkAt(index, available);
+        for (int i = 0; i < available; i++) action(chunk[i]);
+        index += available;
+    }
+}
+
+// ------------------------- новые версии -------------------------
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::PushBack(const T& value) const {
+    PersistentVector<T> result(*this);
+    int inTail = size - tailOffset();
+
+    if (inTail < kWidth) {
+        auto leaf = tail ? std::make_shared<Leaf>(*tail) : std::make_shared<Leaf>();
+        leaf->values[inTail] = value;
+        result.tail = std::move(leaf);
+        result.size++;
+        return result;
+    }
+
+    // хвост полон — он уходит в дерево, новый хвост начинается с value
+    NodePtr tailNode = tail;
+    if ((size >> kBits) > (1 << shift)) {
+        auto newRoot = std::make_shared<Branch>();
+        newRoot->child[0] = root;
+        newRoot->child[1] = newPath(shift, tailNode);
+        result.root = std::move(newRoot);
+        result.shift += kBits;
+    } else {
+        result.root = pushTail(shift, root.get(), tailNode);
+    }
+
+    auto leaf = std::make_shared<Leaf>();
+    leaf->values[0] = value;
+    result.tail = std::move(leaf);
+    result.size++;
+    return result;
+}
+
+template<typename T>
+typename PersistentVector<T>::NodePtr
+PersistentVector<T>::pushTail(int level, const Node* parent, NodePtr tailNode) const {
+    auto copy = parent ? std::make_shared<Branch>(*asBranch(parent)) : std::make_shared<Branch>();
+    int sub = ((size - 1) >> level) & kMask;
+    if (level == kBits) {
+        copy->child[sub] = std::move(tailNode);
+    } else {
+        const Node* child = parent ? asBranch(parent)->child[sub].get() : nullptr;
+        copy->child[sub] = child ? pushTail(level - kBits, child, std::move(tailNode))
+                                 : newPath(level - kBits, std::move(tailNode));
+    }
+    return copy;
+}
+
+template<typename T>
+typename PersistentVector<T>::NodePtr PersistentVector<T>::newPath(int level, NodePtr node) {
+    if (level == 0) return node;
+    auto branch = std::make_shared<Branch>();
+    branch->child[0] = newPath(level - kBits, std::move(node));
+    return branch;
+}
+
+template<typename T>
+PersistentVector<T> PersistentVector<T>::Set(int index, const T& value) const {
+    if (index < 0 || index >= size)
+        throw std::out_of_range("Index out of range");
+    PersistentVector<T> result(*this);
+    if (index >= tailOffset()) {
+        auto leaf = std::make_shared<Leaf>(*tail);
+        leaf->values[index & kMask] = value;
+        result.tail = std::move(leaf);
+    } else {
+        result.root = doSet(shift, root.get(), index, value);
+    }
+    return result;
+}
+
+template<typename T>
+typename PersistentVector<T>::NodePtr
+PersistentVector<T>::doSet(int level, const Node* node, int index, const T& value) {
+    if (level == 0) {
+        auto leaf = std::make_shared<Leaf>(*asLeaf(node));
+        leaf->values[index & kMask] = value;
+        return leaf;
+    }
+    auto branch = std::make_shared<Branch>(*asBranch(node));
+    int sub = (index >> level) & kMask;
+    branch->child[sub] = doSet(level - kBits, branch->child[sub].get(), index, value);
+    return branch;
+}
+
+#endif
@@ -0,0 +1,748 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include "dynamic_array.h"
+#include "persistent_vector.h"
+#include <stdexcept>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <memory>
+#include <cstddef>
+#include <span>
+#include <algorithm>
+
+template<typename T>
+class Sequence {
+public:
+    // Курсор последовательного обхода. Реализации переопределяют CreateCursor,
+    // чтобы Next() стоил O(1) независимо от хранилища (массив, список, ...).
+    // Курсор (и итераторы begin()/end() поверх него) действителен, пока
+    // последовательность не изменена: Append/Prepend/InsertAt у
+    // MutableArraySequence работают на месте и могут перевыделить буфер, на
+    // который курсор указывает. Кто держит курсор между изменениями,
+    // пересоздаёт его (для списков достаточно сверить GetLayoutVersion).
+    class Cursor {
+    public:
+        virtual ~Cursor() = default;
+        virtual bool IsValid() const = 0;
+        virtual T Current() const = 0;
+        virtual void Next() = 0;
+        virtual Cursor* Clone() const = 0;
+    };
+
+    class ConstIterator;
+
+    virtual T Get(int index) const = 0;
+    virtual int GetLength() const = 0;
+    virtual T GetFirst() const = 0;
+    virtual T GetLast() const = 0;
+
+    virtual Sequence<T>* Append(T item) = 0;
+    virtual Sequence<T>* Prepend(T item) = 0;
+    virtual Sequence<T>* InsertAt(int index, T item) = 0;
+    virtual Sequence<T>* GetSubsequence(int startIndex, int endIndex) const = 0;
+    virtual Sequence<T>* Concat(const Sequence<T>& other) const = 0;
+
+    virtual Sequence<T>* CreateFromArray(T* data, int size) const = 0;
+    virtual Sequence<T>* Instance() const = 0;
+    virtual Sequence<T>* Clone() const = 0;
+
+    // Курсор, стоящий на элементе startIndex. По умолчанию ходит через Get(i).
+    // Действителен до изменения последовательности (см. Cursor).
+    virtual std::unique_ptr<Cursor> CreateCursor(int startIndex = 0) const;
+    // Один линейный проход по всем элементам.
+    virtual void ForEach(const std::function<void(const T&)>& action) const;
+    // Непрерывное хранилище без копирования. false — если элементы лежат не подряд
+    // (список, ленивая генерация); тогда следует обходить через ForEach/курсор.
+    virtual bool TryGetContiguous(std::span<const T>& out) const { (void)out; return false; }
+    // Глубина цепочки представлений (SliceSequence/ConcatSequence) до настоящего
+    // хранилища; 0 — сама последовательность хранит элементы.
+    virtual int ViewDepth() const { return 0; }
+    // Счётчик изменений, после которых курсор этой последовательности
+    // недействителен: уже существующие элементы сдвинулись или переехали.
+    // Append в связное хранилище (списки) его не меняет — курсор, стоящий на
+    // последнем элементе, после Next() видит добавленные. Осмыслен только при
+    // ViewDepth() == 0 и без непрерывного хранилища; по умолчанию 0 —
+    // последовательность не меняется на месте.
+    virtual unsigned long long GetLayoutVersion() const { return 0; }
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+    virtual ~Sequence() = default;
+
+protected:
+    class IndexCursor;
+};
+
+// Forward-итератор поверх Cursor: работает с любой реализацией Sequence<T>.
+// Разыменование возвращает значение (как и Get).
+template<typename T>
+class Sequence<T>::ConstIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = T;
+
+    ConstIterator() : cursor(nullptr), index(0) {}
+    ConstIterator(std::unique_ptr<Cursor> c, int startIndex) : cursor(std::move(c)), index(startIndex) {}
+    ConstIterator(const ConstIterator& other)
+        : cursor(other.cursor ? other.cursor->Clone() : nullptr), index(other.index) {}
+    ConstIterator(ConstIterator&& other) noexcept = default;
+
+    ConstIterator& operator=(const ConstIterator& other) {
+        if (this != &other) {
+            cursor.reset(other.cursor ? other.cursor->Clone() : nullptr);
+            index = other.index;
+        }
+        return *this;
+    }
+    ConstIterator& operator=(ConstIterator&& other) noexcept = default;
+
+    T operator*() const { return cursor->Current(); }
+
+    ConstIterator& operator++() {
+        cursor->Next();
+        ++index;
+        return *this;
+    }
+
+    ConstIterator operator++(int) {
+        ConstIterator tmp(*this);
+        ++(*this);
+        return tmp;
+    }
+
+    bool operator==(const ConstIterator& other) const { return index == other.index; }
+    bool operator!=(const ConstIterator& other) const { return index != other.index; }
+
+private:
+    std::unique_ptr<Cursor> cursor;
+    int index;
+};
+
+template<typename T>
+class Sequence<T>::IndexCursor : public Sequence<T>::Cursor {
+public:
+    IndexCursor(const Sequence<T>* s, int startIndex) : seq(s), index(startIndex) {}
+    bool IsValid() const override { return index < seq->GetLength(); }
+    T Current() const override { return seq->Get(index); }
+    void Next() override { ++index; }
+    typename Sequence<T>::Cursor* Clone() const override { return new IndexCursor(*this); }
+private:
+    const Sequence<T>* seq;
+    int index;
+};
+
+template<typename T>
+std::unique_ptr<typename Sequence<T>::Cursor> Sequence<T>::CreateCursor(int startIndex) const {
+    if (startIndex < 0 || startIndex > GetLength())
+        throw std::out_of_range("Index out of range");
+    return std::make_unique<IndexCursor>(this, startIndex);
+}
+
+template<typename T>
+void Sequence<T>::ForEach(const std::function<void(const T&)>& action) const {
+    for (auto cursor = CreateCursor(0); cursor->IsValid(); cursor->Next()) {
+        action(cursor->Current());
+    }
+}
+
+template<typename T>
+typename Sequence<T>::ConstIterator Sequence<T>::begin() const {
+    return ConstIterator(CreateCursor(0), 0);
+}
+
+template<typename T>
+typename Sequence<T>::ConstIterator Sequence<T>::end() const {
+    return ConstIterator(nullptr, GetLength());
+}
+
+template<typename T> class SliceSequence;
+template<typename T> class ConcatSequence;
+
+// ------------------------- ArraySequence -------------------------
+
+template<typename T>
+class ArraySequence : public Sequence<T> {
+protected:
+    // Массив хранится прямо в объекте: короткая последовательность (строка поля,
+    // список соседей) целиком помещается во встроенный буфер DynamicArray и
+    // не обращается к куче вовсе.
+    DynamicArray<T> items;
+
+    class ArrayCursor;
+
+public:
+    ArraySequence(T* data, int count);
+    ArraySequence(int size);
+    ArraySequence(const ArraySequence<T>& other);
+    ArraySequence(ArraySequence<T>&& other);
+    virtual ~ArraySequence();
+
+    T Get(int index) const override;
+    int GetLength() const override;
+    T GetFirst() const override;
+    T GetLast() const override;
+
+    // Append/Prepend/InsertAt остаются чисто виртуальными: их определяет
+    // наследник (MutableArraySequence меняет массив на месте).
+    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override;
+    Sequence<T>* Concat(const Sequence<T>& other) const override;
+    void Set(int index, T value) {
+        items.Set(index, std::move(value));
+    }
+
+    // Доступ по ссылке без проверки границ в Release (см. DynamicArray::operator[]).
+    const T& operator[](int index) const { return items[index]; }
+    const T& UncheckedGet(int index) const { return items[index]; }
+
+    std::unique_ptr<typename Sequence<T>::Cursor> CreateCursor(int startIndex = 0) const override;
+    void ForEach(const std::function<void(const T&)>& action) const override;
+
+    // Буфер DynamicArray как span: действителен, пока последовательность не изменена.
+    std::span<const T> AsSpan() const { return std::span<const T>(items.begin(), items.GetSize()); }
+    bool TryGetContiguous(std::span<const T>& out) const override {
+        out = AsSpan();
+        return true;
+    }
+
+    // Random-access итераторы — указатели в буфер DynamicArray; как и
+    // курсор, действительны, пока последовательность не изменена.
+    const T* begin() const { return items.begin(); }
+    const T* end() const { return items.end(); }
+};
+
+template<typename T>
+class ArraySequence<T>::ArrayCursor : public Sequence<T>::Cursor {
+public:
+    ArrayCursor(const T* first, const T* last) : cur(first), stop(last) {}
+    bool IsValid() const override { return cur != stop; }
+    T Current() const override { return *cur; }
+    void Next() override { ++cur; }
+    typename Sequence<T>::Cursor* Clone() const override { return new ArrayCursor(*this); }
+private:
+    const T* cur;
+    const T* stop;
+};
+
+template<typename T>
+ArraySequence<T>::ArraySequence(T* data, int count) : items(data, count) {}
+
+template<typename T>
+ArraySequence<T>::ArraySequence(int size) : items(size) {}
+
+template<typename T>
+ArraySequence<T>::ArraySequence(const ArraySequence<T>& other) : items(other.items) {}
+
+// Забирает буфер other целиком; other остаётся пустой, но рабочей последовательностью.
+template<typename T>
+ArraySequence<T>::ArraySequence(ArraySequence<T>&& other) : items(std::move(other.items)) {}
+
+template<typename T>
+ArraySequence<T>::~ArraySequence() = default;
+
+template<typename T>
+T ArraySequence<T>::Get(int index) const { return items.Get(index); }
+
+template<typename T>
+int ArraySequence<T>::GetLength() const { return items.GetSize(); }
+
+template<typename T>
+T ArraySequence<T>::GetFirst() const { return Get(0); }
+
+template<typename T>
+T ArraySequence<T>::GetLast() const { return Get(GetLength() - 1); }
+
+template<typename T>
+std::unique_ptr<typename Sequence<T>::Cursor> ArraySequence<T>::CreateCursor(int startIndex) const {
+    if (startIndex < 0 || startIndex > GetLength())
+        throw std::out_of_range("Index out of range");
+    return std::make_unique<ArrayCursor>(items.begin() + startIndex, items.end());
+}
+
+template<typename T>
+void ArraySequence<T>::ForEach(const std::function<void(const T&)>& action) const {
+    for (const T* it = items.begin(); it != items.end(); ++it) {
+        action(*it);
+    }
+}
+
+// GetSubsequence и Concat возвращают представления за O(1) без копирования;
+// this (и other) должны жить, пока живо представление. Представление не
+// MutableArraySequence: его Append не меняет его на месте, а возвращает
+// новую последовательность (см. «Представления» ниже).
+template<typename T>
+Sequence<T>* ArraySequence<T>::GetSubsequence(int startIndex, int endIndex) const {
+    return new SliceSequence<T>(this, startIndex, endIndex);
+}
+
+template<typename T>
+Sequence<T>* ArraySequence<T>::Concat(const Sequence<T>& other) const {
+    return ConcatSequence<T>::Make(this, &other);
+}
+
+
+
+
+// ------------------------- ImmutableArraySequence -------------------------
+
+// Неизменяемая последовательность на персистентном векторе: Append и Set дают
+// новую версию за O(log32 n), разделяя с исходной почти всё дерево, а Clone — O(1).
+// Prepend/InsertAt/GetSubsequence собирают новую версию целиком за O(n).
+template<typename T>
+class ImmutableArraySequence : public Sequence<T> {
+private:
+    PersistentVector<T> items;
+
+    class TrieCursor;
+
+    explicit ImmutableArraySequence(PersistentVector<T> vector) : items(std::move(vector)) {}
+
+public:
+    ImmutableArraySequence() {}
+    ImmutableArraySequence(T* data, int size) : items(data, size) {}
+    ImmutableArraySequence(const ImmutableArraySequence<T>& other) : items(other.items) {}
+    ImmutableArraySequence(ImmutableArraySequence<T>&& other) : items(std::move(other.items)) {}
+
+    T Get(int index) const override { return items.Get(index); }
+    int GetLength() const override { return items.GetSize(); }
+    T GetFirst() const override { return items.Get(0); }
+    T GetLast() const override { return items.Get(items.GetSize() - 1); }
+
+    Sequence<T>* Append(T item) override;
+    Sequence<T>* Prepend(T item) override;
+    Sequence<T>* InsertAt(int index, T item) override;
+    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override;
+    Sequence<T>* Concat(const Sequence<T>& other) const override;
+
+    // Новая версия с заменённым элементом index; исходная не меняется.
+    ImmutableArraySequence<T>* Set(int index, T value) const {
+        return new ImmutableArraySequence<T>(items.Set(index, value));
+    }
+
+    Sequence<T>* CreateFromArray(T* data, int size) const override {
+        return new ImmutableArraySequence<T>(data, size);
+    }
+
+    Sequence<T>* Instance() const override {
+        return new ImmutableArraySequence<T>();
+    }
+
+    Sequence<T>* Clone() const override {
+        return new ImmutableArraySequence<T>(*this);
+    }
+
+    std::unique_ptr<typename Sequence<T>::Cursor> CreateCursor(int startIndex = 0) const override;
+    void ForEach(const std::function<void(const T&)>& action) const override {
+        items.ForEach(action);
+    }
+};
+
+// Идёт по листам дерева: спуск от корня — только при переходе в следующий лист.
+template<typename T>
+class ImmutableArraySequence<T>::TrieCursor : public Sequence<T>::Cursor {
+public:
+    TrieCursor(const PersistentVector<T>* v, int startIndex) : vector(v), index(startIndex), chunk(nullptr), left(0) {
+        load();
+    }
+    bool IsValid() const override { return left > 0; }
+    T Current() const override { return *chunk; }
+    void Next() override {
+        ++index;
+        if (--left > 0) ++chunk;
+        else load();
+    }
+    typename Sequence<T>::Cursor* Clone() const override { return new TrieCursor(*this); }
+private:
+    const PersistentVector<T>* vector;
+    int index;
+    const T* chunk;
+    int left;
+
+    void load() {
+        if (index < vector->GetSize()) chunk = vector->ChunkAt(index, left);
+        else left = 0;
+    }
+};
+
+template<typename T>
+std::unique_ptr<typename Sequence<T>::Cursor> ImmutableArraySequence<T>::CreateCursor(int startIndex) const {
+    if (startIndex < 0 || startIndex > GetLength())
+        throw std::out_of_range("Index out of range");
+    return std::make_unique<TrieCursor>(&items, startIndex);
+}
+
+template<typename T>
+Sequence<T>* ImmutableArraySequence<T>::Append(T item) {
+    return new ImmutableArraySequence<T>(items.PushBack(item));
+}
+
+template<typename T>
+Sequence<T>* ImmutableArraySequence<T>::Prepend(T item) {
+    return InsertAt(0, item);
+}
+
+template<typename T>
+Sequence<T>* ImmutableArraySequence<T>::InsertAt(int index, T item) {
+    int size = GetLength();
+    if (index < 0 || index > size)
+        throw std::out_of_range("Index out of range");
+    T* newData = new T[size + 1];
+    int i = 0;
+    items.ForEach([&](const T& value) {
+        if (i == index) newData[i++] = item;
+        newData[i++] = value;
+    });
+    if (index == size) newData[size] = item;
+    auto* result = new ImmutableArraySequence<T>(newData, size + 1);
+    delete[] newData;
+    return result;
+}
+
+template<typename T>
+Sequence<T>* ImmutableArraySequence<T>::GetSubsequence(int startIndex, int endIndex) const {
+    if (startIndex < 0 || endIndex >= GetLength() || startIndex > endIndex)
+        throw std::out_of_range("Index out of range");
+    int size = endIndex - startIndex + 1;
+    T* newData = new T[size];
+    int i = 0;
+    for (auto cursor = CreateCursor(startIndex); i < size; cursor->Next()) newData[i++] = cursor->Current();
+    auto* result = new ImmutableArraySequence<T>(newData, size);
+    delete[] newData;
+    return result;
+}
+
+// Результат продолжает дерево this: элементы other дописываются по одному.
+template<typename T>
+Sequence<T>* ImmutableArraySequence<T>::Concat(const Sequence<T>& other) const {
+    PersistentVector<T> result = items;
+    other.ForEach([&](const T& value) { result = result.PushBack(value); });
+    return new ImmutableArraySequence<T>(std::move(result));
+}
+
+template<typename T>
+class MutableArraySequence : public ArraySequence<T> {
+public:
+    MutableArraySequence() : ArraySequence<T>(0) {}
+    MutableArraySequence(T* data, int size) : ArraySequence<T>(data, size) {}
+    MutableArraySequence(const MutableArraySequence<T>& other) : ArraySequence<T>(other) {}
+    MutableArraySequence(MutableArraySequence<T>&& other) : ArraySequence<T>(std::move(other)) {}
+
+    Sequence<T>* CreateFromArray(T* data, int size) const override {
+        return new MutableArraySequence<T>(data, size);
+    }
+
+    Sequence<T>* Instance() const override {
+        return new MutableArraySequence<T>();
+    }
+
+    Sequence<T>* Clone() const override {
+        return new MutableArraySequence<T>(*this);
+    }
+
+    void Reserve(int capacity) { this->items.Reserve(capacity); }
+
+    // Изменяемый доступ по ссылке есть только у Mutable-версии.
+    using ArraySequence<T>::operator[];
+    using ArraySequence<T>::UncheckedGet;
+    T& operator[](int index) { return this->items[index]; }
+    T& UncheckedGet(int index) { return this->items[index]; }
+
+    // Изменяемая версия меняет саму себя и возвращает this (без копирования массива).
+    // Append — амортизированно O(1) за счёт запаса ёмкости в DynamicArray.
+    Sequence<T>* Append(T item) override {
+        this->items.PushBack(item);
+        return this;
+    }
+
+    Sequence<T>* Prepend(T item) override {
+        this->items.Insert(0, item);
+        return this;
+    }
+
+    Sequence<T>* InsertAt(int index, T item) override {
+        this->items.Insert(index, item);
+        return this;
+    }
+
+    MutableArraySequence& operator=(const MutableArraySequence& other) {
+        if (this != &other) {
+            this->items = other.items;
+        }
+        return *this;
+    }
+
+    MutableArraySequence& operator=(MutableArraySequence&& other) noexcept {
+        if (this != &other) {
+            this->items = std::move(other.items);
+        }
+        return *this;
+    }
+
+};
+
+
+
+
+// ------------------------- Представления (rope) -------------------------
+//
+// SliceSequence и ConcatSequence не владеют источниками и не копируют элементы:
+// Get/курсор обращаются к источнику по требованию, поэтому окно и конкатенация
+// строятся за O(1) и видят последующие изменения источника. Источники должны
+// жить дольше представления.
+//
+// Представление само не изменяется, как Immutable-последовательности:
+// Append/Prepend/InsertAt возвращают новую MutableArraySequence (копию окна
+// с изменением), которой владеет вызывающий, а представление остаётся прежним
+// и удаляется отдельно — `v = v->Append(x)` без delete теряет v. Flatten()
+// материализует явно. Clone тоже возвращает материализованную копию: она не
+// зависит от времени жизни источников.
+
+template<typename T>
+class SliceSequence : public Sequence<T> {
+public:
+    // Окно [startIndex, endIndex] источника; окно над окном ссылается прямо на исходник.
+    SliceSequence(const Sequence<T>* source, int startIndex, int endIndex);
+
+    T Get(int index) const override;
+    int GetLength() const override { return length; }
+    T GetFirst() const override { return Get(0); }
+    T GetLast() const override { return Get(length - 1); }
+
+    Sequence<T>* Append(T item) override { return Flatten()->Append(item); }
+    Sequence<T>* Prepend(T item) override { return Flatten()->Prepend(item); }
+    Sequence<T>* InsertAt(int index, T item) override { return Flatten()->InsertAt(index, item); }
+    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override;
+    Sequence<T>* Concat(const Sequence<T>& other) const override { return ConcatSequence<T>::Make(this, &other); }
+
+    Sequence<T>* CreateFromArray(T* data, int size) const override { return new MutableArraySequence<T>(data, size); }
+    Sequence<T>* Instance() const override { return new MutableArraySequence<T>(); }
+    Sequence<T>* Clone() const override { return Flatten(); }
+
+    std::unique_ptr<typename Sequence<T>::Cursor> CreateCursor(int startIndex = 0) const override;
+    void ForEach(const std::function<void(const T&)>& action) const override;
+    bool TryGetContiguous(std::span<const T>& out) const override;
+    int ViewDepth() const override { return source->ViewDepth() + 1; }
+
+    // Копия элементов окна в собственный массив.
+    MutableArraySequence<T>* Flatten() const;
+
+private:
+    const Sequence<T>* source;
+    int offset;
+    int length;
+
+    class SliceCursor;
+};
+
+template<typename T>
+class ConcatSequence : public Sequence<T> {
+public:
+    // Глубже kMaxDepth цепочка не растёт: Make материализует результат,
+    // чтобы Get не проходил через слишком много уровней.
+    static constexpr int kMaxDepth = 16;
+
+    // left + right: представление, либо (при превышении kMaxDepth) новый массив.
+    static Sequence<T>* Make(const Sequence<T>* left, const Sequence<T>* right);
+
+    T Get(int index) const override;
+    int GetLength() const override { return left->GetLength() + right->GetLength(); }
+    T GetFirst() const override { return Get(0); }
+    T GetLast() const override { return Get(GetLength() - 1); }
+
+    Sequence<T>* Append(T item) override { return Flatten()->Append(item); }
+    Sequence<T>* Prepend(T item) override { return Flatten()->Prepend(item); }
+    Sequence<T>* InsertAt(int index, T item) override { return Flatten()->InsertAt(index, item); }
+    Sequence<T>* GetSubsequence(int startIndex, int endIndex) const override;
+    Sequence<T>* Concat(const Sequence<T>& other) const override { return Make(this, &other); }
+
+    Sequence<T>* CreateFromArray(T* data, int size) const override { return new MutableArraySequence<T>(data, size); }
+    Sequence<T>* Instance() const override { return new MutableArraySequence<T>(); }
+    Sequence<T>* Clone() const override { return Flatten(); }
+
+    std::unique_ptr<typename Sequence<T>::Cursor> CreateCursor(int startIndex = 0) const override;
+    void ForEach(const std::function<void(const T&)>& action) const override;
+    int ViewDepth() const override { return depth; }
+
+    MutableArraySequence<T>* Flatten() const;
+
+private:
+    const Sequence<T>* left;
+    const Sequence<T>* right;
+    int depth;
+
+    ConcatSequence(const Sequence<T>* l, const Sequence<T>* r, int d) : left(l), right(r), depth(d) {}
+
+    class ConcatCursor;
+};
+
+// Материализация любой последовательности одним проходом.
+template<typename T>
+MutableArraySequence<T>* FlattenSequence(const Sequence<T>& seq) {
+    auto* result = new MutableArraySequence<T>();
+    result->Reserve(seq.GetLength());
+    seq.ForEach([&](const T& value) { result->Append(value); });
+    return result;
+}
+
+// ------------------------- SliceSequence -------------------------
+
+template<typename T>
+class SliceSequence<T>::SliceCursor : public Sequence<T>::Cursor {
+public:
+    SliceCursor(std::unique_ptr<typename Sequence<T>::Cursor> c, int remaining) : inner(std::move(c)), left(remaining) {}
+    bool IsValid() const override { return left > 0; }
+    T Current() const override { return inner->Current(); }
+    void Next() override {
+        if (--left > 0) inner->Next();
+    }
+    typename Sequence<T>::Cursor* Clone() const override {
+        return new SliceCursor(std::unique_ptr<typename Sequence<T>::Cursor>(inner->Clone()), left);
+    }
+private:
+    std::unique_ptr<typename Sequence<T>::Cursor> inner;
+    int left;
+};
+
+template<typename T>
+SliceSequence<T>::SliceSequence(const Sequence<T>* src, int startIndex, int endIndex)
+    : source(src), offset(startIndex), length(endIndex - startIndex + 1) {
+    if (startIndex < 0 || endIndex >= src->GetLength() || startIndex > endIndex)
+        throw std::out_of_range("Index out of range");
+    if (auto* slice = dynamic_cast<const SliceSequence<T>*>(src)) {
+        source = slice->source;
+        offset += slice->offset;
+    }
+}
+
+template<typename T>
+T SliceSequence<T>::Get(int index) const {
+    if (index < 0 || index >= length)
+        throw std::out_of_range("Index out of range");
+    return source->Get(offset + index);
+}
+
+template<typename T>
+Sequence<T>* SliceSequence<T>::GetSubsequence(int startIndex, int endIndex) const {
+    return new SliceSequence<T>(this, startIndex, endIndex);
+}
+
+template<typename T>
+std::unique_ptr<typename Sequence<T>::Cursor> SliceSequence<T>::CreateCursor(int startIndex) const {
+    if (startIndex < 0 || startIndex > length)
+        throw std::out_of_range("Index out of range");
+    return std::make_unique<SliceCursor>(source->CreateCursor(offset + startIndex), length - startIndex);
+}
+
+template<typename T>
+void SliceSequence<T>::ForEach(const std::function<void(const T&)>& action) const {
+    std::span<const T> span;
+    if (TryGetContiguous(span)) {
+        for (const T& value : span) action(value);
+        return;
+    }
+    for (auto cursor = CreateCursor(0); cursor->IsValid(); cursor->Next()) {
+        action(cursor->Current());
+    }
+}
+
+template<typename T>
+bool SliceSequence<T>::TryGetContiguous(std::span<const T>& out) const {
+    std::span<const T> whole;
+    if (!source->TryGetContiguous(whole)) return false;
+    out = whole.subspan(offset, length);
+    return true;
+}
+
+template<typename T>
+MutableArraySequence<T>* SliceSequence<T>::Flatten() const {
+    return FlattenSequence<T>(*this);
+}
+
+// ------------------------- ConcatSequence -------------------------
+
+// Переходит от левого курсора к правому, когда левый кончается.
+template<typename T>
+class ConcatSequence<T>::ConcatCursor : public Sequence<T>::Cursor {
+public:
+    ConcatCursor(std::unique_ptr<typename Sequence<T>::Cursor> c, const Sequence<T>* r, bool onLeft)
+        : cur(std::move(c)), right(r), inLeft(onLeft) {
+        skipToRight();
+    }
+    bool IsValid() const override { return cur->IsValid(); }
+    T Current() const override { return cur->Current(); }
+    void Next() override {
+        cur->Next();
+        skipToRight();
+    }
+    typename Sequence<T>::Cursor* Clone() const override {
+        return new ConcatCursor(std::unique_ptr<typename Sequence<T>::Cursor>(cur->Clone()), right, inLeft);
+    }
+private:
+    std::unique_ptr<typename Sequence<T>::Cursor> cur;
+    const Sequence<T>* right;
+    bool inLeft;
+
+    void skipToRight() {
+        if (inLeft && !cur->IsValid()) {
+            cur = right->CreateCursor(0);
+            inLeft = false;
+        }
+    }
+};
+
+template<typename T>
+Sequence<T>* ConcatSequence<T>::Make(const Sequence<T>* left, const Sequence<T>* right) {
+    int depth = std::max(left->ViewDepth(), right->ViewDepth()) + 1;
+    if (depth <= kMaxDepth) return new ConcatSequence<T>(left, right, depth);
+    auto* result = FlattenSequence<T>(*left);
+    right->ForEach([&](const T& value) { result->Append(value); });
+    return result;
+}
+
+template<typename T>
+T ConcatSequence<T>::Get(int index) const {
+    int leftLength = left->GetLength();
+    if (index < 0 || index >= leftLength + right->GetLength())
+        throw std::out_of_range("Index out of range");
+    return index < leftLength ? left->Get(index) : right->Get(index - leftLength);
+}
+
+// Окно целиком в одной половине — берём его прямо у неё, минуя этот узел.
+template<typename T>
+Sequence<T>* ConcatSequence<T>::GetSubsequence(int startIndex, int endIndex) const {
+    int leftLength = left->GetLength();
+    if (endIndex < leftLength && startIndex >= 0 && startIndex <= endIndex)
+        return new SliceSequence<T>(left, startIndex, endIndex);
+    if (startIndex >= leftLength && startIndex <= endIndex)
+        return new SliceSequence<T>(right, startIndex - leftLength, endIndex - leftLength);
+    return new SliceSequence<T>(this, startIndex, endIndex);
+}
+
+template<typename T>
+std::unique_ptr<typename Sequence<T>::Cursor> ConcatSequence<T>::CreateCursor(int startIndex) const {
+    int leftLength = left->GetLength();
+    if (startIndex < 0 || startIndex > leftLength + right->GetLength())
+        throw std::out_of_range("Index out of range");
+    if (startIndex < leftLength)
+        return std::make_unique<ConcatCursor>(left->CreateCursor(startIndex), right, true);
+    return std::make_unique<ConcatCursor>(right->CreateCursor(startIndex - leftLength), right, false);
+}
+
+template<typename T>
+void ConcatSequence<T>::ForEach(const std::function<void(const T&)>& action) const {
+    left->ForEach(action);
+    right->ForEach(action);
+}
+
+template<typename T>
+MutableArraySequence<T>* ConcatSequence<T>::Flatten() const {
+    return FlattenSequence<T>(*this);
+}
+
+
+#endif